@@ -0,0 +1,103 @@
+///------------------------------------------------------------------------------------------------
+///  BatchCollidersBenchmark.cpp
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/BatchColliders.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+static std::vector<network::ObjectData> CreateRandomObjects(const size_t objectCount, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> positionDistribution(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> dimensionsDistribution(0.02f, 0.2f);
+    std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+    
+    std::vector<network::ObjectData> objects(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        auto& objectData = objects[i];
+        objectData.objectId = i;
+        objectData.position = glm::vec3(positionDistribution(rng), positionDistribution(rng), 0.0f);
+        objectData.objectScale = scaleDistribution(rng);
+        objectData.colliderData.colliderType = rng() % 2 == 0 ? network::ColliderType::RECTANGLE : network::ColliderType::CIRCLE;
+        objectData.colliderData.colliderRelativeDimensions = glm::vec2(dimensionsDistribution(rng), dimensionsDistribution(rng));
+    }
+    
+    return objects;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int main()
+{
+    constexpr size_t QUERY_COUNT = 256;
+    constexpr int ITERATIONS = 2000;
+    const size_t candidateCounts[] = { 8, 16, 32, 64 };
+    
+    std::mt19937 rng(1337);
+    const auto queries = CreateRandomObjects(QUERY_COUNT, rng);
+    
+    std::printf("candidates  scalar ns/query  batch ns/query  speedup\n");
+    for (const auto candidateCount: candidateCounts)
+    {
+        const auto candidates = CreateRandomObjects(candidateCount, rng);
+        
+        network::BatchColliderSet batchColliderSet;
+        for (const auto& candidate: candidates)
+        {
+            batchColliderSet.AddCollider(candidate);
+        }
+        
+        size_t scalarHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < ITERATIONS; ++iteration)
+        {
+            for (const auto& query: queries)
+            {
+                for (const auto& candidate: candidates)
+                {
+                    scalarHits += query.objectId != candidate.objectId && network::CollidersIntersect(query, candidate) ? 1 : 0;
+                }
+            }
+        }
+        const auto scalarNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        
+        size_t batchHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < ITERATIONS; ++iteration)
+        {
+            for (const auto& query: queries)
+            {
+                batchColliderSet.ForEachIntersectingCollider(query, [&](const size_t){ batchHits++; });
+            }
+        }
+        const auto batchNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        
+        // Both paths must agree on every single pair, not just on the totals
+        for (const auto& query: queries)
+        {
+            std::vector<bool> batchResults(candidateCount, false);
+            batchColliderSet.ForEachIntersectingCollider(query, [&](const size_t colliderIndex){ batchResults[colliderIndex] = true; });
+            for (size_t i = 0; i < candidateCount; ++i)
+            {
+                if (batchResults[i] != (query.objectId != candidates[i].objectId && network::CollidersIntersect(query, candidates[i])))
+                {
+                    std::printf("Mismatch between the batch and scalar results for object %d\n", static_cast<int>(candidates[i].objectId));
+                    return 1;
+                }
+            }
+        }
+        
+        const auto totalQueries = static_cast<double>(QUERY_COUNT) * ITERATIONS;
+        std::printf("%10zu  %15.1f  %14.1f  %6.2fx  (hits %zu/%zu)\n", candidateCount, scalarNanos / totalQueries, batchNanos / totalQueries, scalarNanos / batchNanos, scalarHits, batchHits);
+    }
+    
+    return 0;
+}
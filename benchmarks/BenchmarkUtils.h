@@ -0,0 +1,152 @@
+///------------------------------------------------------------------------------------------------
+///  BenchmarkUtils.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef BenchmarkUtils_h
+#define BenchmarkUtils_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkCommon.h>
+#include <tools/PngLoader.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace benchmarks
+{
+
+///------------------------------------------------------------------------------------------------
+
+enum class ObjectDistribution
+{
+    UNIFORM,
+    CLUSTERED
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* GetObjectDistributionName(const ObjectDistribution distribution)
+{
+    return distribution == ObjectDistribution::UNIFORM ? "uniform" : "clustered";
+}
+
+///------------------------------------------------------------------------------------------------
+
+struct BenchmarkResult
+{
+    std::string mName;
+    std::string mWorkload;
+    size_t mObjectCount;
+    size_t mOperationsPerRun;
+    int mRuns;
+    double mMedianNanos;
+    double mMinNanos;
+    uint64_t mChecksum; // Keeps the measured work observable, and should match across releases
+};
+
+///------------------------------------------------------------------------------------------------
+/// Runs the benchmark body a few times and keeps the median and fastest run. The body returns
+/// a checksum of whatever it computed.
+template<typename BodyT>
+inline BenchmarkResult RunBenchmark(const std::string& name, const std::string& workload, const size_t objectCount, const size_t operationsPerRun, const int runs, BodyT&& body)
+{
+    std::vector<double> runNanos;
+    uint64_t checksum = 0;
+    for (int i = 0; i < runs; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checksum = body();
+        runNanos.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    
+    std::sort(runNanos.begin(), runNanos.end());
+    return BenchmarkResult{ name, workload, objectCount, operationsPerRun, runs, runNanos[runNanos.size()/2], runNanos.front(), checksum };
+}
+
+///------------------------------------------------------------------------------------------------
+/// Seeded synthetic objects in a map sized world (MAP_GAME_SCALE units across), either spread
+/// uniformly or bunched up in a few swarms.
+inline std::vector<network::ObjectData> CreateObjects(const size_t objectCount, const ObjectDistribution distribution, const uint32_t seed)
+{
+    constexpr int CLUSTER_COUNT = 8;
+    
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uniformPositionDistribution(-network::MAP_GAME_SCALE * 0.5f, network::MAP_GAME_SCALE * 0.5f);
+    std::uniform_real_distribution<float> clusterCenterDistribution(-network::MAP_GAME_SCALE * 0.35f, network::MAP_GAME_SCALE * 0.35f);
+    std::normal_distribution<float> clusterOffsetDistribution(0.0f, network::MAP_GAME_SCALE * 0.04f);
+    std::uniform_real_distribution<float> dimensionsDistribution(network::MAP_TILE_SIZE * 0.5f, network::MAP_TILE_SIZE * 2.0f);
+    
+    glm::vec2 clusterCenters[CLUSTER_COUNT];
+    for (auto& clusterCenter: clusterCenters)
+    {
+        clusterCenter = glm::vec2(clusterCenterDistribution(rng), clusterCenterDistribution(rng));
+    }
+    
+    std::vector<network::ObjectData> objects(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        auto& objectData = objects[i];
+        objectData.objectId = static_cast<network::objectId_t>(i + 1);
+        objectData.objectScale = 1.0f;
+        objectData.colliderData.colliderType = rng() % 2 == 0 ? network::ColliderType::RECTANGLE : network::ColliderType::CIRCLE;
+        objectData.colliderData.colliderRelativeDimensions = glm::vec2(dimensionsDistribution(rng), dimensionsDistribution(rng));
+        
+        if (distribution == ObjectDistribution::UNIFORM)
+        {
+            objectData.position = glm::vec3(uniformPositionDistribution(rng), uniformPositionDistribution(rng), 0.0f);
+        }
+        else
+        {
+            const auto& clusterCenter = clusterCenters[i % CLUSTER_COUNT];
+            objectData.position = glm::vec3(clusterCenter.x + clusterOffsetDistribution(rng), clusterCenter.y + clusterOffsetDistribution(rng), 0.0f);
+        }
+    }
+    
+    return objects;
+}
+
+///------------------------------------------------------------------------------------------------
+
+using tools::LoadPngRGBA;
+
+///------------------------------------------------------------------------------------------------
+
+inline void WriteResultsCsv(std::FILE* output, const std::vector<BenchmarkResult>& results)
+{
+    std::fprintf(output, "name,workload,objects,operations_per_run,runs,median_ns,min_ns,median_ns_per_op,checksum\n");
+    for (const auto& result: results)
+    {
+        std::fprintf(output, "%s,%s,%zu,%zu,%d,%.0f,%.0f,%.3f,%llu\n", result.mName.c_str(), result.mWorkload.c_str(), result.mObjectCount, result.mOperationsPerRun, result.mRuns, result.mMedianNanos, result.mMinNanos, result.mMedianNanos / static_cast<double>(std::max(result.mOperationsPerRun, size_t(1))), static_cast<unsigned long long>(result.mChecksum));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void WriteResultsJson(std::FILE* output, const std::vector<BenchmarkResult>& results, const char* version, const char* commitHash)
+{
+    std::fprintf(output, "{\n  \"version\": \"%s\",\n  \"commit\": \"%s\",\n  \"results\": [\n", version, commitHash);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        std::fprintf(output, "    { \"name\": \"%s\", \"workload\": \"%s\", \"objects\": %zu, \"operations_per_run\": %zu, \"runs\": %d, \"median_ns\": %.0f, \"min_ns\": %.0f, \"median_ns_per_op\": %.3f, \"checksum\": %llu }%s\n", result.mName.c_str(), result.mWorkload.c_str(), result.mObjectCount, result.mOperationsPerRun, result.mRuns, result.mMedianNanos, result.mMinNanos, result.mMedianNanos / static_cast<double>(std::max(result.mOperationsPerRun, size_t(1))), static_cast<unsigned long long>(result.mChecksum), i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(output, "  ]\n}\n");
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* BenchmarkUtils_h */
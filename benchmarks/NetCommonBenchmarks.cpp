@@ -0,0 +1,701 @@
+///------------------------------------------------------------------------------------------------
+///  NetCommonBenchmarks.cpp
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+///  Seeded benchmarks of the net_common hot paths, with machine readable output so that runs of
+///  different releases can be compared:
+///
+///      net_common_benchmarks [--format=json|csv] [--output=<file>] [--assets=<net_assets dir>]
+///                            [--filter=<name substring>] [--quick]
+///------------------------------------------------------------------------------------------------
+
+#include "BenchmarkUtils.h"
+#include <net_common/CookedWorldAssets.h>
+#include <net_common/FlatNetworkQuadtree.h>
+#include <net_common/LayeredBroadphase.h>
+#include <net_common/MapGlobalData.h>
+#include <net_common/Navmap.h>
+#include <net_common/NetworkMessages.h>
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/NetworkSpatialGrid.h>
+#include <net_common/ObjectTable.h>
+#include <net_common/PackedNavmap.h>
+#include <net_common/ParallelCollisions.h>
+#include <net_common/SweptQueries.h>
+#include <net_common/Version.h>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+#ifndef NET_COMMON_ASSETS_DIR
+#define NET_COMMON_ASSETS_DIR "net_assets"
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+using namespace benchmarks;
+
+static constexpr uint32_t BENCHMARK_SEED = 1337;
+static constexpr int BENCHMARK_RUNS = 5;
+static constexpr size_t MAX_QUERIES_PER_RUN = 1000;
+static constexpr size_t MAX_ALL_PAIRS_OBJECT_COUNT = 10000;
+static constexpr size_t NAVMAP_LOOKUPS_PER_RUN = 1000000;
+static constexpr size_t NAVMAP_RAYCASTS_PER_RUN = 100000;
+static constexpr float PROJECTILE_TICK_DISTANCE = 0.2f;
+static constexpr int PROJECTILE_SUBSTEPS = 8;
+static const char* NAVMAP_NAMES[] = { "forest_1", "forest_2", "forest_3", "forest_4", "forest_5" };
+
+///------------------------------------------------------------------------------------------------
+
+struct BenchmarkOptions
+{
+    std::string mFormat = "json";
+    std::string mOutputPath;
+    std::string mAssetsDirectory = NET_COMMON_ASSETS_DIR;
+    std::string mFilter;
+    bool mQuick = false;
+};
+
+///------------------------------------------------------------------------------------------------
+
+static bool ShouldRun(const BenchmarkOptions& options, const std::string& name)
+{
+    return options.mFilter.empty() || name.find(options.mFilter) != std::string::npos;
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename BroadphaseT>
+static void RunBroadphaseBenchmarks(const std::string& broadphaseName, const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    const glm::vec3 mapDimensions(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f);
+    BroadphaseT broadphase(glm::vec3(0.0f), mapDimensions);
+    
+    if (ShouldRun(options, broadphaseName + "_build"))
+    {
+        results.push_back(RunBenchmark(broadphaseName + "_build", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+        {
+            broadphase.Clear();
+            broadphase.PopulateSceneGraph(objects);
+            return uint64_t(objects.size());
+        }));
+    }
+    
+    broadphase.Clear();
+    broadphase.PopulateSceneGraph(objects);
+    
+    if (ShouldRun(options, broadphaseName + "_collision_candidates"))
+    {
+        // A fixed, evenly spread sample of the objects as queries, so that 100k object runs stay short
+        const auto queryStride = std::max(objects.size() / MAX_QUERIES_PER_RUN, size_t(1));
+        const auto queryCount = (objects.size() + queryStride - 1) / queryStride;
+        
+        std::vector<network::objectId_t> collisionCandidates;
+        results.push_back(RunBenchmark(broadphaseName + "_collision_candidates", workload, objects.size(), queryCount, BENCHMARK_RUNS, [&]()
+        {
+            uint64_t candidateCount = 0;
+            for (size_t i = 0; i < objects.size(); i += queryStride)
+            {
+                broadphase.GetCollisionCandidates(objects[i], collisionCandidates);
+                candidateCount += collisionCandidates.size();
+            }
+            return candidateCount;
+        }));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename BroadphaseT>
+static void RunAllCollidingPairsBenchmark(const std::string& broadphaseName, const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (objects.size() > MAX_ALL_PAIRS_OBJECT_COUNT || !ShouldRun(options, broadphaseName + "_all_colliding_pairs"))
+    {
+        return;
+    }
+    
+    BroadphaseT broadphase(glm::vec3(0.0f), glm::vec3(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f));
+    broadphase.PopulateSceneGraph(objects);
+    
+    results.push_back(RunBenchmark(broadphaseName + "_all_colliding_pairs", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+    {
+        uint64_t collidingPairCount = 0;
+        broadphase.FindAllCollidingPairs(objects, [&](const network::ObjectData&, const network::ObjectData&){ collidingPairCount++; });
+        return collidingPairCount;
+    }));
+}
+
+///------------------------------------------------------------------------------------------------
+/// Forest like maps, with 4 in 5 objects being STATIC. The per tick build only covers the movers,
+/// as the static layer is built once up front (and measured separately).
+static void RunLayeredBroadphaseBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (!ShouldRun(options, "layered_broadphase"))
+    {
+        return;
+    }
+    
+    auto mapObjects = objects;
+    std::vector<network::ObjectData> movingObjects;
+    for (size_t i = 0; i < mapObjects.size(); ++i)
+    {
+        mapObjects[i].objectType = i % 5 == 0 ? network::ObjectType::NPC : network::ObjectType::STATIC;
+        if (mapObjects[i].objectType != network::ObjectType::STATIC)
+        {
+            movingObjects.push_back(mapObjects[i]);
+        }
+    }
+    
+    network::LayeredBroadphase broadphase(glm::vec3(0.0f), glm::vec3(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f));
+    results.push_back(RunBenchmark("layered_broadphase_static_build", workload, mapObjects.size(), mapObjects.size(), BENCHMARK_RUNS, [&]()
+    {
+        broadphase.BuildStaticLayer(mapObjects);
+        return uint64_t(broadphase.GetStaticLayer().GetObjectCount());
+    }));
+    
+    results.push_back(RunBenchmark("layered_broadphase_build", workload, mapObjects.size(), movingObjects.size(), BENCHMARK_RUNS, [&]()
+    {
+        broadphase.Clear();
+        broadphase.PopulateSceneGraph(movingObjects);
+        return uint64_t(movingObjects.size());
+    }));
+    
+    std::vector<network::objectId_t> collisionCandidates;
+    results.push_back(RunBenchmark("layered_broadphase_collision_candidates", workload, mapObjects.size(), movingObjects.size(), BENCHMARK_RUNS, [&]()
+    {
+        uint64_t candidateCount = 0;
+        for (const auto& objectData: movingObjects)
+        {
+            broadphase.GetCollisionCandidates(objectData, collisionCandidates);
+            candidateCount += collisionCandidates.size();
+        }
+        return candidateCount;
+    }));
+}
+
+///------------------------------------------------------------------------------------------------
+/// Scaling of the parallel pass from 1 thread up to the hardware concurrency (in powers of two).
+static void RunParallelCollidingPairsBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (objects.size() > MAX_ALL_PAIRS_OBJECT_COUNT || !ShouldRun(options, "quadtree_parallel_colliding_pairs"))
+    {
+        return;
+    }
+    
+    network::NetworkQuadtree quadtree(glm::vec3(0.0f), glm::vec3(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f));
+    quadtree.PopulateSceneGraph(objects);
+    
+    const auto maxThreadCount = static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<size_t> threadCounts;
+    for (size_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(maxThreadCount);
+    
+    for (const auto threadCount: threadCounts)
+    {
+        network::JobPool jobPool(threadCount);
+        network::ParallelCollisionPass collisionPass;
+        std::vector<network::ObjectIdPair> collidingPairs;
+        
+        results.push_back(RunBenchmark("quadtree_parallel_colliding_pairs_" + std::to_string(threadCount) + "t", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+        {
+            collisionPass.FindAllCollidingPairs(quadtree, objects, jobPool, collidingPairs);
+            return static_cast<uint64_t>(collidingPairs.size());
+        }));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+/// One tick of fast projectiles: a single swept query each, against sub-stepping them with
+/// overlap tests as an update would otherwise have to.
+static void RunSweptQueryBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (objects.empty() || (!ShouldRun(options, "swept_projectile_queries") && !ShouldRun(options, "substepped_projectile_queries")))
+    {
+        return;
+    }
+    
+    network::NetworkQuadtree quadtree(glm::vec3(0.0f), glm::vec3(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f));
+    quadtree.PopulateSceneGraph(objects);
+    
+    std::mt19937 rng(BENCHMARK_SEED);
+    std::uniform_real_distribution<float> angleDistribution(0.0f, 6.2831853f);
+    std::vector<network::ObjectData> projectiles(std::min(MAX_QUERIES_PER_RUN, objects.size()));
+    std::vector<glm::vec3> nextPositions(projectiles.size());
+    std::vector<network::SweptQuery> queries(projectiles.size());
+    for (size_t i = 0; i < projectiles.size(); ++i)
+    {
+        const auto angle = angleDistribution(rng);
+        projectiles[i] = objects[i];
+        projectiles[i].objectId = network::objectId_t(~0u) - network::objectId_t(i);
+        projectiles[i].parentObjectId = objects[i].objectId;
+        nextPositions[i] = projectiles[i].position + glm::vec3(std::cos(angle) * PROJECTILE_TICK_DISTANCE, std::sin(angle) * PROJECTILE_TICK_DISTANCE, 0.0f);
+        queries[i] = network::CreateProjectileSweptQuery(projectiles[i], nextPositions[i]);
+    }
+    
+    if (ShouldRun(options, "swept_projectile_queries"))
+    {
+        network::SweptQueryScene<> scene;
+        scene.mQuadtree = &quadtree;
+        scene.mNetObjectData = &objects;
+        
+        std::vector<network::SweptHit> hits;
+        results.push_back(RunBenchmark("swept_projectile_queries", workload, objects.size(), queries.size(), BENCHMARK_RUNS, [&]()
+        {
+            network::FindFirstSweptHits(scene, queries, hits);
+            return static_cast<uint64_t>(std::count_if(hits.begin(), hits.end(), [](const network::SweptHit& hit){ return hit.mHitType != network::SweptHitType::NONE; }));
+        }));
+    }
+    
+    if (ShouldRun(options, "substepped_projectile_queries"))
+    {
+        std::unordered_map<network::objectId_t, size_t> objectIndices;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            objectIndices[objects[i].objectId] = i;
+        }
+        
+        results.push_back(RunBenchmark("substepped_projectile_queries", workload, objects.size(), queries.size(), BENCHMARK_RUNS, [&]()
+        {
+            uint64_t hitCount = 0;
+            for (size_t i = 0; i < projectiles.size(); ++i)
+            {
+                auto projectileData = projectiles[i];
+                auto isHit = false;
+                for (int substep = 1; substep <= PROJECTILE_SUBSTEPS && !isHit; ++substep)
+                {
+                    projectileData.position = projectiles[i].position + (nextPositions[i] - projectiles[i].position) * (static_cast<float>(substep) / PROJECTILE_SUBSTEPS);
+                    quadtree.ForEachCollisionCandidate(projectileData, [&](const network::objectId_t candidateObjectId)
+                    {
+                        const auto& candidateData = objects[objectIndices.at(candidateObjectId)];
+                        isHit = isHit || (candidateObjectId != projectileData.parentObjectId && network::CollidersIntersect(projectileData, candidateData));
+                    });
+                }
+                hitCount += isHit ? 1 : 0;
+            }
+            return hitCount;
+        }));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void RunColliderBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (!ShouldRun(options, "colliders_intersect"))
+    {
+        return;
+    }
+    
+    // Pseudo random pairs, mixing all rectangle/circle combinations
+    results.push_back(RunBenchmark("colliders_intersect", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+    {
+        uint64_t hitCount = 0;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            hitCount += network::CollidersIntersect(objects[i], objects[(i * 7919 + 1) % objects.size()]) ? 1 : 0;
+        }
+        return hitCount;
+    }));
+}
+
+///------------------------------------------------------------------------------------------------
+
+/// The same per tick movement pass over std::vector<ObjectData> and over an ObjectTable, plus
+/// broadphase builds straight from the table.
+static void RunObjectTableBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    const float dt = 1.0f/60.0f;
+    
+    if (ShouldRun(options, "object_data_tick"))
+    {
+        auto tickObjects = objects;
+        results.push_back(RunBenchmark("object_data_tick", workload, tickObjects.size(), tickObjects.size(), BENCHMARK_RUNS, [&]()
+        {
+            uint64_t checksum = 0;
+            for (auto& objectData: tickObjects)
+            {
+                objectData.position += objectData.velocity * dt;
+                objectData.actionTimer += dt;
+                checksum += objectData.objectState == network::ObjectState::RUNNING || objectData.position.x > 0.0f ? 1 : 0;
+            }
+            return checksum;
+        }));
+    }
+    
+    network::ObjectTable objectTable;
+    objectTable.Reserve(objects.size());
+    for (const auto& objectData: objects)
+    {
+        objectTable.AddObject(objectData);
+    }
+    
+    if (ShouldRun(options, "object_table_tick"))
+    {
+        results.push_back(RunBenchmark("object_table_tick", workload, objectTable.GetObjectCount(), objectTable.GetObjectCount(), BENCHMARK_RUNS, [&]()
+        {
+            auto& positions = objectTable.GetPositions();
+            auto& actionTimers = objectTable.GetActionTimers();
+            const auto& velocities = objectTable.GetVelocities();
+            const auto& objectStates = objectTable.GetObjectStates();
+            
+            uint64_t checksum = 0;
+            for (size_t i = 0; i < objectTable.GetObjectCount(); ++i)
+            {
+                positions[i] += velocities[i] * dt;
+                actionTimers[i] += dt;
+                checksum += objectStates[i] == network::ObjectState::RUNNING || positions[i].x > 0.0f ? 1 : 0;
+            }
+            return checksum;
+        }));
+    }
+    
+    if (ShouldRun(options, "quadtree_build_from_table"))
+    {
+        network::NetworkQuadtree quadtree(glm::vec3(0.0f), glm::vec3(network::MAP_GAME_SCALE, network::MAP_GAME_SCALE, 1.0f));
+        results.push_back(RunBenchmark("quadtree_build_from_table", workload, objectTable.GetObjectCount(), objectTable.GetObjectCount(), BENCHMARK_RUNS, [&]()
+        {
+            quadtree.Clear();
+            quadtree.PopulateSceneGraph(objectTable);
+            return uint64_t(objectTable.GetObjectCount());
+        }));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static void RunMessageBenchmarks(const std::vector<network::ObjectData>& objects, const std::string& workload, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (ShouldRun(options, "message_construction"))
+    {
+        std::vector<unsigned char> messageBuffer(sizeof(network::ObjectStateUpdateMessage));
+        results.push_back(RunBenchmark("message_construction", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+        {
+            uint64_t checksum = 0;
+            for (const auto& objectData: objects)
+            {
+                network::ObjectStateUpdateMessage message = {};
+                message.objectData = objectData;
+                std::memcpy(messageBuffer.data(), &message, sizeof(message));
+                checksum += messageBuffer[sizeof(network::MessageHeader)] + static_cast<uint64_t>(message.objectData.objectId);
+            }
+            return checksum;
+        }));
+    }
+    
+    if (ShouldRun(options, "message_version_validity"))
+    {
+        // A third each of current, older and newer versions
+        const char* versions[] = { NET_COMMON_VERSION, "0.0.1", "99.0.0" };
+        std::vector<std::vector<unsigned char>> rawMessages(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            network::ObjectStateUpdateMessage message = {};
+            message.objectData = objects[i];
+            std::memset(message.__header.version, 0, sizeof(message.__header.version));
+            std::strncpy(message.__header.version, versions[i % 3], sizeof(message.__header.version) - 1);
+            
+            rawMessages[i].resize(sizeof(message));
+            std::memcpy(rawMessages[i].data(), &message, sizeof(message));
+        }
+        
+        results.push_back(RunBenchmark("message_version_validity", workload, objects.size(), objects.size(), BENCHMARK_RUNS, [&]()
+        {
+            uint64_t validMessageCount = 0;
+            for (auto& rawMessage: rawMessages)
+            {
+                validMessageCount += network::GetMessageVersionValidity(rawMessage.data()) == network::MessageVersionValidityEnum::VALID ? 1 : 0;
+            }
+            return validMessageCount;
+        }));
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+static bool RunNavmapBenchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (!ShouldRun(options, "navmap_get_tile") && !ShouldRun(options, "packed_navmap_get_tile") && !ShouldRun(options, "navmap_raycast"))
+    {
+        return true;
+    }
+    
+    for (const auto* navmapName: NAVMAP_NAMES)
+    {
+        const auto navmapPath = options.mAssetsDirectory + "/navmaps/" + network::GetMapNavmapFileName(navmapName);
+        
+        std::vector<unsigned char> navmapPixels;
+        int navmapWidth = 0, navmapHeight = 0;
+        if (!LoadPngRGBA(navmapPath, navmapPixels, navmapWidth, navmapHeight) || navmapWidth != navmapHeight)
+        {
+            std::fprintf(stderr, "Could not load navmap %s\n", navmapPath.c_str());
+            return false;
+        }
+        
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<int> coordDistribution(0, navmapWidth - 1);
+        std::vector<glm::ivec2> lookupCoords(NAVMAP_LOOKUPS_PER_RUN);
+        for (auto& lookupCoord: lookupCoords)
+        {
+            lookupCoord = glm::ivec2(coordDistribution(rng), coordDistribution(rng));
+        }
+        
+        const network::Navmap navmap(navmapPixels.data(), navmapWidth);
+        if (ShouldRun(options, "navmap_get_tile"))
+        {
+            results.push_back(RunBenchmark("navmap_get_tile", navmapName, lookupCoords.size(), lookupCoords.size(), BENCHMARK_RUNS, [&]()
+            {
+                uint64_t tileTypeSum = 0;
+                for (const auto& lookupCoord: lookupCoords)
+                {
+                    tileTypeSum += static_cast<uint64_t>(navmap.GetNavmapTileAt(lookupCoord));
+                }
+                return tileTypeSum;
+            }));
+        }
+        
+        const network::PackedNavmap packedNavmap(navmap);
+        if (ShouldRun(options, "packed_navmap_get_tile"))
+        {
+            results.push_back(RunBenchmark("packed_navmap_get_tile", navmapName, lookupCoords.size(), lookupCoords.size(), BENCHMARK_RUNS, [&]()
+            {
+                uint64_t tileTypeSum = 0;
+                for (const auto& lookupCoord: lookupCoords)
+                {
+                    tileTypeSum += static_cast<uint64_t>(packedNavmap.GetNavmapTileAt(lookupCoord));
+                }
+                return tileTypeSum;
+            }));
+        }
+        
+        if (ShouldRun(options, "navmap_raycast"))
+        {
+            std::uniform_real_distribution<float> positionDistribution(-network::MAP_GAME_SCALE / 2.0f, network::MAP_GAME_SCALE / 2.0f);
+            std::uniform_real_distribution<float> angleDistribution(0.0f, 6.2831853f);
+            std::vector<std::pair<glm::vec3, glm::vec3>> segments(NAVMAP_RAYCASTS_PER_RUN);
+            for (auto& segment: segments)
+            {
+                const auto angle = angleDistribution(rng);
+                segment.first = glm::vec3(positionDistribution(rng), positionDistribution(rng), 0.0f);
+                segment.second = segment.first + glm::vec3(std::cos(angle) * PROJECTILE_TICK_DISTANCE, std::sin(angle) * PROJECTILE_TICK_DISTANCE, 0.0f);
+            }
+            
+            results.push_back(RunBenchmark("packed_navmap_raycast", navmapName, segments.size(), segments.size(), BENCHMARK_RUNS, [&]()
+            {
+                uint64_t hitCount = 0;
+                float timeOfImpact = 0.0f;
+                glm::ivec2 navmapCoord;
+                for (const auto& segment: segments)
+                {
+                    hitCount += network::RaycastNavmap(packedNavmap, glm::vec2(0.0f), network::MAP_GAME_SCALE, segment.first, segment.second, timeOfImpact, navmapCoord) ? 1 : 0;
+                }
+                return hitCount;
+            }));
+        }
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Server startup: decoding the navmap pngs and parsing map_global_data.json, against mapping the
+/// cooked blob of the same assets. Both end with the map global data and a PackedNavmap per map.
+static bool RunWorldAssetsBenchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+{
+    if (!ShouldRun(options, "world_assets_png_load") && !ShouldRun(options, "world_assets_cooked_load"))
+    {
+        return true;
+    }
+    
+    auto loadSourceAssets = [&](network::MapGlobalData& outMapGlobalData, std::vector<std::vector<unsigned char>>& outNavmapPixels, std::vector<int>& outNavmapSizes)
+    {
+        if (!network::LoadMapGlobalData(options.mAssetsDirectory + "/map_global_data.json", outMapGlobalData))
+        {
+            return false;
+        }
+        
+        outNavmapPixels.resize(outMapGlobalData.mMapDefinitions.size());
+        outNavmapSizes.resize(outMapGlobalData.mMapDefinitions.size());
+        size_t mapIndex = 0;
+        for (const auto& mapDefinitionEntry: outMapGlobalData.mMapDefinitions)
+        {
+            int navmapHeight = 0;
+            if (!LoadPngRGBA(options.mAssetsDirectory + "/navmaps/" + network::GetMapNavmapFileName(mapDefinitionEntry.first), outNavmapPixels[mapIndex], outNavmapSizes[mapIndex], navmapHeight) || navmapHeight != outNavmapSizes[mapIndex])
+            {
+                return false;
+            }
+            ++mapIndex;
+        }
+        return true;
+    };
+    
+    network::MapGlobalData mapGlobalData;
+    std::vector<std::vector<unsigned char>> navmapPixels;
+    std::vector<int> navmapSizes;
+    std::vector<network::CookedNavmapSource> navmapSources;
+    std::vector<unsigned char> cookedBlob;
+    if (loadSourceAssets(mapGlobalData, navmapPixels, navmapSizes))
+    {
+        size_t mapIndex = 0;
+        for (const auto& mapDefinitionEntry: mapGlobalData.mMapDefinitions)
+        {
+            navmapSources.push_back(network::CookedNavmapSource{ mapDefinitionEntry.first, navmapPixels[mapIndex].data(), navmapSizes[mapIndex] });
+            ++mapIndex;
+        }
+    }
+    
+    const auto cookedFilePath = (std::filesystem::temp_directory_path() / network::COOKED_WORLD_ASSETS_FILE_NAME).string();
+    if (navmapSources.empty() || !network::CookWorldAssets(mapGlobalData, navmapSources, cookedBlob) || !network::WriteCookedWorldAssets(cookedFilePath, cookedBlob))
+    {
+        std::fprintf(stderr, "Could not cook the world assets of %s\n", options.mAssetsDirectory.c_str());
+        return false;
+    }
+    
+    const auto mapCount = navmapSources.size();
+    if (ShouldRun(options, "world_assets_png_load"))
+    {
+        results.push_back(RunBenchmark("world_assets_png_load", "net_assets", mapCount, mapCount, BENCHMARK_RUNS, [&]()
+        {
+            network::MapGlobalData loadedMapGlobalData;
+            std::vector<std::vector<unsigned char>> loadedNavmapPixels;
+            std::vector<int> loadedNavmapSizes;
+            uint64_t solidTileCount = 0;
+            if (loadSourceAssets(loadedMapGlobalData, loadedNavmapPixels, loadedNavmapSizes))
+            {
+                for (size_t i = 0; i < loadedNavmapPixels.size(); ++i)
+                {
+                    const network::PackedNavmap packedNavmap(loadedNavmapPixels[i].data(), loadedNavmapSizes[i]);
+                    solidTileCount += packedNavmap.CountTilesInRegion(glm::ivec2(0), glm::ivec2(loadedNavmapSizes[i] - 1), network::NavmapTileType::SOLID);
+                }
+            }
+            return solidTileCount;
+        }));
+    }
+    
+    if (ShouldRun(options, "world_assets_cooked_load"))
+    {
+        results.push_back(RunBenchmark("world_assets_cooked_load", "net_assets", mapCount, mapCount, BENCHMARK_RUNS, [&]()
+        {
+            network::CookedWorldAssets cookedWorldAssets;
+            network::MapGlobalData loadedMapGlobalData;
+            uint64_t solidTileCount = 0;
+            if (cookedWorldAssets.LoadFromFile(cookedFilePath))
+            {
+                cookedWorldAssets.GetMapGlobalData(loadedMapGlobalData);
+                for (size_t i = 0; i < cookedWorldAssets.GetMapCount(); ++i)
+                {
+                    const auto packedNavmap = cookedWorldAssets.GetPackedNavmap(i);
+                    solidTileCount += packedNavmap.CountTilesInRegion(glm::ivec2(0), glm::ivec2(packedNavmap.GetSize() - 1), network::NavmapTileType::SOLID);
+                }
+            }
+            return solidTileCount;
+        }));
+    }
+    
+    std::remove(cookedFilePath.c_str());
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+static bool ParseOptions(int argc, char** argv, BenchmarkOptions& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument(argv[i]);
+        auto readValue = [&](const char* prefix, std::string& outValue)
+        {
+            const auto prefixLength = std::strlen(prefix);
+            if (argument.compare(0, prefixLength, prefix) != 0)
+            {
+                return false;
+            }
+            
+            outValue = argument.substr(prefixLength);
+            return true;
+        };
+        
+        if (argument == "--quick")
+        {
+            outOptions.mQuick = true;
+        }
+        else if (!readValue("--format=", outOptions.mFormat) && !readValue("--output=", outOptions.mOutputPath) && !readValue("--assets=", outOptions.mAssetsDirectory) && !readValue("--filter=", outOptions.mFilter))
+        {
+            return false;
+        }
+    }
+    
+    return outOptions.mFormat == "json" || outOptions.mFormat == "csv";
+}
+
+///------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--format=json|csv] [--output=<file>] [--assets=<net_assets dir>] [--filter=<name substring>] [--quick]\n", argv[0]);
+        return 1;
+    }
+    
+    std::vector<BenchmarkResult> results;
+    const std::vector<size_t> objectCounts = options.mQuick ? std::vector<size_t>{ 1000, 10000 } : std::vector<size_t>{ 1000, 10000, 100000 };
+    for (const auto objectCount: objectCounts)
+    {
+        for (const auto distribution: { ObjectDistribution::UNIFORM, ObjectDistribution::CLUSTERED })
+        {
+            const auto objects = CreateObjects(objectCount, distribution, BENCHMARK_SEED);
+            const std::string workload = GetObjectDistributionName(distribution);
+            
+            RunBroadphaseBenchmarks<network::NetworkQuadtree>("quadtree", objects, workload, options, results);
+            RunBroadphaseBenchmarks<network::FlatNetworkQuadtree>("flat_quadtree", objects, workload, options, results);
+            RunBroadphaseBenchmarks<network::NetworkSpatialGrid>("spatial_grid", objects, workload, options, results);
+            RunAllCollidingPairsBenchmark<network::NetworkQuadtree>("quadtree", objects, workload, options, results);
+            RunAllCollidingPairsBenchmark<network::NetworkSpatialGrid>("spatial_grid", objects, workload, options, results);
+            RunParallelCollidingPairsBenchmarks(objects, workload, options, results);
+            RunLayeredBroadphaseBenchmarks(objects, workload, options, results);
+            RunSweptQueryBenchmarks(objects, workload, options, results);
+            RunColliderBenchmarks(objects, workload, options, results);
+            RunObjectTableBenchmarks(objects, workload, options, results);
+            RunMessageBenchmarks(objects, workload, options, results);
+        }
+    }
+    
+    if (!RunNavmapBenchmarks(options, results))
+    {
+        return 1;
+    }
+    
+    if (!RunWorldAssetsBenchmarks(options, results))
+    {
+        return 1;
+    }
+    
+    auto* output = options.mOutputPath.empty() ? stdout : std::fopen(options.mOutputPath.c_str(), "w");
+    if (!output)
+    {
+        std::fprintf(stderr, "Could not open %s for writing\n", options.mOutputPath.c_str());
+        return 1;
+    }
+    
+    if (options.mFormat == "csv")
+    {
+        WriteResultsCsv(output, results);
+    }
+    else
+    {
+        WriteResultsJson(output, results, NET_COMMON_VERSION, NET_COMMON_COMMIT_HASH);
+    }
+    
+    if (output != stdout)
+    {
+        std::fclose(output);
+    }
+    
+    return 0;
+}
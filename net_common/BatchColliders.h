@@ -0,0 +1,373 @@
+///------------------------------------------------------------------------------------------------
+///  BatchColliders.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef BATCH_COLLIDERS_H
+#define BATCH_COLLIDERS_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkCommon.h>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define NET_COMMON_BATCH_COLLIDERS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NET_COMMON_BATCH_COLLIDERS_SSE
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+namespace batch_lanes
+{
+
+///------------------------------------------------------------------------------------------------
+/// Lane policies the intersection kernels are written against. Min/Max follow the
+/// minps/maxps semantics (a < b ? a : b), which for finite values is what math::Min/Max do.
+struct ScalarLanes
+{
+    using float_lanes_t = float;
+    using mask_lanes_t = bool;
+    static constexpr size_t LANE_COUNT = 1;
+    
+    static inline float_lanes_t Load(const float* values) { return *values; }
+    static inline float_lanes_t Broadcast(const float value) { return value; }
+    static inline float_lanes_t Add(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs + rhs; }
+    static inline float_lanes_t Sub(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs - rhs; }
+    static inline float_lanes_t Mul(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs * rhs; }
+    static inline float_lanes_t Min(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs < rhs ? lhs : rhs; }
+    static inline float_lanes_t Max(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs > rhs ? lhs : rhs; }
+    static inline mask_lanes_t Greater(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs > rhs; }
+    static inline mask_lanes_t Less(const float_lanes_t lhs, const float_lanes_t rhs) { return lhs < rhs; }
+    static inline mask_lanes_t Or(const mask_lanes_t lhs, const mask_lanes_t rhs) { return lhs || rhs; }
+    static inline uint32_t MoveMask(const mask_lanes_t mask) { return mask ? 1u : 0u; }
+};
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(NET_COMMON_BATCH_COLLIDERS_SSE) || defined(NET_COMMON_BATCH_COLLIDERS_AVX)
+struct SseLanes
+{
+    using float_lanes_t = __m128;
+    using mask_lanes_t = __m128;
+    static constexpr size_t LANE_COUNT = 4;
+    
+    static inline float_lanes_t Load(const float* values) { return _mm_loadu_ps(values); }
+    static inline float_lanes_t Broadcast(const float value) { return _mm_set1_ps(value); }
+    static inline float_lanes_t Add(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_add_ps(lhs, rhs); }
+    static inline float_lanes_t Sub(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_sub_ps(lhs, rhs); }
+    static inline float_lanes_t Mul(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_mul_ps(lhs, rhs); }
+    static inline float_lanes_t Min(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_min_ps(lhs, rhs); }
+    static inline float_lanes_t Max(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_max_ps(lhs, rhs); }
+    static inline mask_lanes_t Greater(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_cmpgt_ps(lhs, rhs); }
+    static inline mask_lanes_t Less(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm_cmplt_ps(lhs, rhs); }
+    static inline mask_lanes_t Or(const mask_lanes_t lhs, const mask_lanes_t rhs) { return _mm_or_ps(lhs, rhs); }
+    static inline uint32_t MoveMask(const mask_lanes_t mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+};
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+#if defined(NET_COMMON_BATCH_COLLIDERS_AVX)
+struct AvxLanes
+{
+    using float_lanes_t = __m256;
+    using mask_lanes_t = __m256;
+    static constexpr size_t LANE_COUNT = 8;
+    
+    static inline float_lanes_t Load(const float* values) { return _mm256_loadu_ps(values); }
+    static inline float_lanes_t Broadcast(const float value) { return _mm256_set1_ps(value); }
+    static inline float_lanes_t Add(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_add_ps(lhs, rhs); }
+    static inline float_lanes_t Sub(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_sub_ps(lhs, rhs); }
+    static inline float_lanes_t Mul(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_mul_ps(lhs, rhs); }
+    static inline float_lanes_t Min(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_min_ps(lhs, rhs); }
+    static inline float_lanes_t Max(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_max_ps(lhs, rhs); }
+    static inline mask_lanes_t Greater(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ); }
+    static inline mask_lanes_t Less(const float_lanes_t lhs, const float_lanes_t rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+    static inline mask_lanes_t Or(const mask_lanes_t lhs, const mask_lanes_t rhs) { return _mm256_or_ps(lhs, rhs); }
+    static inline uint32_t MoveMask(const mask_lanes_t mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+};
+
+using WidestLanes = AvxLanes;
+#elif defined(NET_COMMON_BATCH_COLLIDERS_SSE)
+using WidestLanes = SseLanes;
+#else
+using WidestLanes = ScalarLanes;
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+/// Structure of arrays collider storage for batched narrow phase tests: one collider is
+/// tested against many candidates (typically the quadtree's collision candidates) at a time.
+/// Colliders are grouped by ColliderType, and the world space extents that
+/// RectToRectIntersectionCheck & co recompute per pair are computed once on insertion,
+/// with the exact same float operations. Results are therefore bit identical to
+/// CollidersIntersect for finite inputs, as long as the compiler is not allowed to contract
+/// the scalar functions' multiply-adds into FMAs (-ffp-contract=off or no FMA target).
+class BatchColliderSet final
+{
+public:
+    inline void Clear()
+    {
+        mObjectIds.clear();
+        mRectangles.Clear();
+        mCircles.Clear();
+    }
+    
+    inline void Reserve(const size_t colliderCount)
+    {
+        mObjectIds.reserve(colliderCount);
+        mRectangles.Reserve(colliderCount);
+        mCircles.Reserve(colliderCount);
+    }
+    
+    /// Returns the index of the collider in the set, as reported to the query visitors.
+    inline size_t AddCollider(const ObjectData& objectData)
+    {
+        const auto colliderIndex = static_cast<uint32_t>(mObjectIds.size());
+        const auto colliderExtents = ColliderExtents(objectData);
+        
+        if (objectData.colliderData.colliderType == ColliderType::RECTANGLE)
+        {
+            mRectangles.mLeft.push_back(colliderExtents.mLeft);
+            mRectangles.mRight.push_back(colliderExtents.mRight);
+            mRectangles.mTop.push_back(colliderExtents.mTop);
+            mRectangles.mBottom.push_back(colliderExtents.mBottom);
+            mRectangles.mClampRight.push_back(colliderExtents.mClampRight);
+            mRectangles.mClampBottom.push_back(colliderExtents.mClampBottom);
+            mRectangles.mColliderIndices.push_back(colliderIndex);
+        }
+        else
+        {
+            mCircles.mX.push_back(objectData.position.x);
+            mCircles.mY.push_back(objectData.position.y);
+            mCircles.mRadius.push_back(colliderExtents.mRadius);
+            mCircles.mRectRadiusSquared.push_back(colliderExtents.mRectRadiusSquared);
+            mCircles.mColliderIndices.push_back(colliderIndex);
+        }
+        
+        mObjectIds.push_back(objectData.objectId);
+        return colliderIndex;
+    }
+    
+    inline size_t GetColliderCount() const { return mObjectIds.size(); }
+    inline objectId_t GetColliderObjectId(const size_t colliderIndex) const { return mObjectIds[colliderIndex]; }
+    
+    /// Calls visitor(colliderIndex) for every collider in the set that CollidersIntersect with
+    /// objectData. Rectangles are reported first, then circles, each in insertion order.
+    /// Like the quadtree's collision candidates, colliders with objectData's own id are skipped.
+    template<typename VisitorT>
+    inline void ForEachIntersectingCollider(const ObjectData& objectData, VisitorT&& visitor) const
+    {
+        const auto queryExtents = ColliderExtents(objectData);
+        auto otherColliderVisitor = [&](const size_t colliderIndex)
+        {
+            if (mObjectIds[colliderIndex] != objectData.objectId)
+            {
+                visitor(colliderIndex);
+            }
+        };
+        
+        if (objectData.colliderData.colliderType == ColliderType::RECTANGLE)
+        {
+            RunBatchedKernel(mRectangles.mColliderIndices, [&](auto lanes, const size_t i){ return RectToRectHitMask(lanes, queryExtents, i); }, otherColliderVisitor);
+            RunBatchedKernel(mCircles.mColliderIndices, [&](auto lanes, const size_t i){ return RectToCircleHitMask(lanes, queryExtents, objectData, i); }, otherColliderVisitor);
+        }
+        else
+        {
+            RunBatchedKernel(mRectangles.mColliderIndices, [&](auto lanes, const size_t i){ return CircleToRectHitMask(lanes, queryExtents, objectData, i); }, otherColliderVisitor);
+            RunBatchedKernel(mCircles.mColliderIndices, [&](auto lanes, const size_t i){ return CircleToCircleHitMask(lanes, queryExtents, objectData, i); }, otherColliderVisitor);
+        }
+    }
+    
+    /// Clears and fills outObjectIds with the ids of the intersecting colliders.
+    inline void GetIntersectingColliders(const ObjectData& objectData, std::vector<objectId_t>& outObjectIds) const
+    {
+        outObjectIds.clear();
+        ForEachIntersectingCollider(objectData, [&](const size_t colliderIndex){ outObjectIds.push_back(mObjectIds[colliderIndex]); });
+    }
+
+private:
+    struct ColliderExtents
+    {
+        ColliderExtents(const ObjectData& objectData)
+        {
+            // Same expressions as in RectToRectIntersectionCheck/RectToCircleIntersectionCheck/CircleToCircleIntersectionCheck
+            const auto scaledWidth = objectData.objectScale * objectData.colliderData.colliderRelativeDimensions.x;
+            const auto scaledHeight = objectData.objectScale * objectData.colliderData.colliderRelativeDimensions.y;
+            
+            mLeft = objectData.position.x - scaledWidth/2.0f;
+            mRight = objectData.position.x + scaledWidth/2.0f;
+            mTop = objectData.position.y + scaledHeight/2.0f;
+            mBottom = objectData.position.y - scaledHeight/2.0f;
+            mClampRight = mLeft + scaledWidth;
+            mClampBottom = mTop - scaledHeight;
+            mRadius = scaledWidth/2.0f;
+            mRectRadiusSquared = (scaledWidth/2.0f) * (scaledHeight/2.0f);
+        }
+        
+        float mLeft;
+        float mRight;
+        float mTop;
+        float mBottom;
+        float mClampRight;
+        float mClampBottom;
+        float mRadius;
+        float mRectRadiusSquared;
+    };
+    
+    struct RectangleColliders
+    {
+        void Clear()
+        {
+            mLeft.clear(); mRight.clear(); mTop.clear(); mBottom.clear(); mClampRight.clear(); mClampBottom.clear(); mColliderIndices.clear();
+        }
+        
+        void Reserve(const size_t colliderCount)
+        {
+            mLeft.reserve(colliderCount); mRight.reserve(colliderCount); mTop.reserve(colliderCount); mBottom.reserve(colliderCount);
+            mClampRight.reserve(colliderCount); mClampBottom.reserve(colliderCount); mColliderIndices.reserve(colliderCount);
+        }
+        
+        std::vector<float> mLeft;
+        std::vector<float> mRight;
+        std::vector<float> mTop;
+        std::vector<float> mBottom;
+        std::vector<float> mClampRight;
+        std::vector<float> mClampBottom;
+        std::vector<uint32_t> mColliderIndices;
+    };
+    
+    struct CircleColliders
+    {
+        void Clear()
+        {
+            mX.clear(); mY.clear(); mRadius.clear(); mRectRadiusSquared.clear(); mColliderIndices.clear();
+        }
+        
+        void Reserve(const size_t colliderCount)
+        {
+            mX.reserve(colliderCount); mY.reserve(colliderCount); mRadius.reserve(colliderCount); mRectRadiusSquared.reserve(colliderCount); mColliderIndices.reserve(colliderCount);
+        }
+        
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mRadius;
+        std::vector<float> mRectRadiusSquared;
+        std::vector<uint32_t> mColliderIndices;
+    };
+    
+    /// Runs the kernel over full chunks of the widest lanes available and finishes the
+    /// remainder with the scalar lanes.
+    template<typename KernelT, typename VisitorT>
+    static inline void RunBatchedKernel(const std::vector<uint32_t>& colliderIndices, KernelT&& kernel, VisitorT& visitor)
+    {
+        constexpr auto LANE_COUNT = batch_lanes::WidestLanes::LANE_COUNT;
+        const auto colliderCount = colliderIndices.size();
+        
+        size_t i = 0;
+        for (; i + LANE_COUNT <= colliderCount; i += LANE_COUNT)
+        {
+            const auto hitMask = kernel(batch_lanes::WidestLanes(), i);
+            if (hitMask == 0)
+            {
+                continue;
+            }
+            
+            for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+            {
+                if (hitMask & (1u << lane))
+                {
+                    visitor(static_cast<size_t>(colliderIndices[i + lane]));
+                }
+            }
+        }
+        
+        for (; i < colliderCount; ++i)
+        {
+            if (kernel(batch_lanes::ScalarLanes(), i))
+            {
+                visitor(static_cast<size_t>(colliderIndices[i]));
+            }
+        }
+    }
+    
+    template<typename LanesT>
+    static inline uint32_t AllLanesMask()
+    {
+        return (1u << LanesT::LANE_COUNT) - 1u;
+    }
+    
+    template<typename LanesT>
+    inline uint32_t RectToRectHitMask(LanesT, const ColliderExtents& query, const size_t i) const
+    {
+        const auto separated = LanesT::Or(LanesT::Or(LanesT::Greater(LanesT::Broadcast(query.mLeft), LanesT::Load(&mRectangles.mRight[i])),
+                                                     LanesT::Less(LanesT::Broadcast(query.mRight), LanesT::Load(&mRectangles.mLeft[i]))),
+                                          LanesT::Or(LanesT::Less(LanesT::Broadcast(query.mTop), LanesT::Load(&mRectangles.mBottom[i])),
+                                                     LanesT::Greater(LanesT::Broadcast(query.mBottom), LanesT::Load(&mRectangles.mTop[i]))));
+        return ~LanesT::MoveMask(separated) & AllLanesMask<LanesT>();
+    }
+    
+    template<typename LanesT>
+    inline uint32_t RectToCircleHitMask(LanesT, const ColliderExtents& query, const ObjectData&, const size_t i) const
+    {
+        const auto circleX = LanesT::Load(&mCircles.mX[i]);
+        const auto circleY = LanesT::Load(&mCircles.mY[i]);
+        const auto clampedX = LanesT::Max(LanesT::Broadcast(query.mLeft), LanesT::Min(circleX, LanesT::Broadcast(query.mClampRight)));
+        const auto clampedY = LanesT::Max(LanesT::Broadcast(query.mClampBottom), LanesT::Min(circleY, LanesT::Broadcast(query.mTop)));
+        const auto deltaX = LanesT::Sub(circleX, clampedX);
+        const auto deltaY = LanesT::Sub(circleY, clampedY);
+        const auto distanceSquared = LanesT::Add(LanesT::Mul(deltaX, deltaX), LanesT::Mul(deltaY, deltaY));
+        return LanesT::MoveMask(LanesT::Less(distanceSquared, LanesT::Load(&mCircles.mRectRadiusSquared[i])));
+    }
+    
+    template<typename LanesT>
+    inline uint32_t CircleToRectHitMask(LanesT, const ColliderExtents& query, const ObjectData& objectData, const size_t i) const
+    {
+        const auto circleX = LanesT::Broadcast(objectData.position.x);
+        const auto circleY = LanesT::Broadcast(objectData.position.y);
+        const auto clampedX = LanesT::Max(LanesT::Load(&mRectangles.mLeft[i]), LanesT::Min(circleX, LanesT::Load(&mRectangles.mClampRight[i])));
+        const auto clampedY = LanesT::Max(LanesT::Load(&mRectangles.mClampBottom[i]), LanesT::Min(circleY, LanesT::Load(&mRectangles.mTop[i])));
+        const auto deltaX = LanesT::Sub(circleX, clampedX);
+        const auto deltaY = LanesT::Sub(circleY, clampedY);
+        const auto distanceSquared = LanesT::Add(LanesT::Mul(deltaX, deltaX), LanesT::Mul(deltaY, deltaY));
+        return LanesT::MoveMask(LanesT::Less(distanceSquared, LanesT::Broadcast(query.mRectRadiusSquared)));
+    }
+    
+    template<typename LanesT>
+    inline uint32_t CircleToCircleHitMask(LanesT, const ColliderExtents& query, const ObjectData& objectData, const size_t i) const
+    {
+        const auto deltaX = LanesT::Sub(LanesT::Broadcast(objectData.position.x), LanesT::Load(&mCircles.mX[i]));
+        const auto deltaY = LanesT::Sub(LanesT::Broadcast(objectData.position.y), LanesT::Load(&mCircles.mY[i]));
+        const auto distanceSquared = LanesT::Add(LanesT::Mul(deltaX, deltaX), LanesT::Mul(deltaY, deltaY));
+        const auto radiusSum = LanesT::Add(LanesT::Broadcast(query.mRadius), LanesT::Load(&mCircles.mRadius[i]));
+        return LanesT::MoveMask(LanesT::Less(distanceSquared, LanesT::Mul(radiusSum, radiusSum)));
+    }
+
+private:
+    std::vector<objectId_t> mObjectIds;
+    RectangleColliders mRectangles;
+    CircleColliders mCircles;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // BATCH_COLLIDERS_H
@@ -0,0 +1,212 @@
+///------------------------------------------------------------------------------------------------
+///  BitStream.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef BIT_STREAM_H
+#define BIT_STREAM_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// Minimal LSB-first bit writer over a caller owned, fixed capacity byte buffer.
+/// Writing past the capacity does not touch memory past the buffer, it just
+/// flags the stream as overflown so the caller can bail out.
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* buffer, const size_t capacityBytes)
+    : mBuffer(buffer)
+    , mCapacityBytes(capacityBytes)
+    , mBitPosition(0)
+    , mOverflown(false)
+    {
+        std::memset(mBuffer, 0, mCapacityBytes);
+    }
+    
+    inline void WriteBits(uint32_t value, int bitCount)
+    {
+        while (bitCount > 0)
+        {
+            const size_t byteIndex = mBitPosition >> 3;
+            if (byteIndex >= mCapacityBytes)
+            {
+                mOverflown = true;
+                return;
+            }
+            
+            const int bitOffset = static_cast<int>(mBitPosition & 7);
+            const int bitsInByte = bitCount < 8 - bitOffset ? bitCount : 8 - bitOffset;
+            mBuffer[byteIndex] |= static_cast<uint8_t>((value & ((1u << bitsInByte) - 1u)) << bitOffset);
+            
+            value >>= bitsInByte;
+            bitCount -= bitsInByte;
+            mBitPosition += bitsInByte;
+        }
+    }
+    
+    inline void WriteBool(const bool value)
+    {
+        WriteBits(value ? 1u : 0u, 1);
+    }
+    
+    inline void WriteVarUInt(uint64_t value)
+    {
+        do
+        {
+            const uint32_t group = static_cast<uint32_t>(value & 0x7F);
+            value >>= 7;
+            WriteBits(group | (value ? 0x80u : 0u), 8);
+        } while (value);
+    }
+    
+    inline void WriteVarInt(const int64_t value)
+    {
+        // Zigzag so that small negative deltas stay small on the wire
+        WriteVarUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    
+    inline void WriteFloat(const float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        WriteBits(bits, 32);
+    }
+    
+    inline void WriteString(const char* str, const size_t maxLength)
+    {
+        const auto length = strnlen(str, maxLength);
+        WriteVarUInt(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            WriteBits(static_cast<uint8_t>(str[i]), 8);
+        }
+    }
+    
+    inline size_t GetBytesWritten() const { return (mBitPosition + 7) >> 3; }
+    inline bool HasOverflown() const { return mOverflown; }
+
+private:
+    uint8_t* mBuffer;
+    const size_t mCapacityBytes;
+    size_t mBitPosition;
+    bool mOverflown;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Reader counterpart of the BitWriter. Reads past the end of the buffer return
+/// zeroes and flag the stream as overflown (i.e. malformed input).
+class BitReader
+{
+public:
+    BitReader(const uint8_t* buffer, const size_t sizeBytes)
+    : mBuffer(buffer)
+    , mSizeBytes(sizeBytes)
+    , mBitPosition(0)
+    , mOverflown(false)
+    {
+    }
+    
+    inline uint32_t ReadBits(const int bitCount)
+    {
+        uint32_t value = 0;
+        int bitsRead = 0;
+        while (bitsRead < bitCount)
+        {
+            const size_t byteIndex = mBitPosition >> 3;
+            if (byteIndex >= mSizeBytes)
+            {
+                mOverflown = true;
+                return 0;
+            }
+            
+            const int bitOffset = static_cast<int>(mBitPosition & 7);
+            const int bitsInByte = bitCount - bitsRead < 8 - bitOffset ? bitCount - bitsRead : 8 - bitOffset;
+            value |= static_cast<uint32_t>((mBuffer[byteIndex] >> bitOffset) & ((1u << bitsInByte) - 1u)) << bitsRead;
+            
+            bitsRead += bitsInByte;
+            mBitPosition += bitsInByte;
+        }
+        
+        return value;
+    }
+    
+    inline bool ReadBool()
+    {
+        return ReadBits(1) != 0;
+    }
+    
+    inline uint64_t ReadVarUInt()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            const uint32_t group = ReadBits(8);
+            value |= static_cast<uint64_t>(group & 0x7F) << shift;
+            if (!(group & 0x80) || mOverflown)
+            {
+                return value;
+            }
+        }
+        
+        mOverflown = true;
+        return value;
+    }
+    
+    inline int64_t ReadVarInt()
+    {
+        const uint64_t zigzag = ReadVarUInt();
+        return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    }
+    
+    inline float ReadFloat()
+    {
+        const uint32_t bits = ReadBits(32);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    
+    inline void ReadString(char* str, const size_t capacity)
+    {
+        const auto length = ReadVarUInt();
+        if (length >= capacity)
+        {
+            mOverflown = true;
+            str[0] = '\0';
+            return;
+        }
+        
+        for (size_t i = 0; i < length; ++i)
+        {
+            str[i] = static_cast<char>(ReadBits(8));
+        }
+        str[length] = '\0';
+    }
+    
+    inline bool HasOverflown() const { return mOverflown; }
+
+private:
+    const uint8_t* mBuffer;
+    const size_t mSizeBytes;
+    size_t mBitPosition;
+    bool mOverflown;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // BIT_STREAM_H
@@ -0,0 +1,310 @@
+///------------------------------------------------------------------------------------------------
+///  CompactMessages.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef COMPACT_MESSAGES_H
+#define COMPACT_MESSAGES_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkMessages.h>
+#include <unordered_map>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// Compact wire format, used once a peer's version has been validated by the handshake:
+///
+///     [type][sequence (optional)][message fields]
+///
+/// The type byte has its high bit set when a 16 bit sequence number follows. The message
+/// fields are sent as laid out in the message struct, starting at its first field, so the 16
+/// byte version string of the full MessageHeader (and the padding after it) is dropped.
+inline constexpr uint8_t COMPACT_MESSAGE_SEQUENCE_FLAG = 0x80;
+inline constexpr size_t COMPACT_MESSAGE_MAX_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t);
+
+///------------------------------------------------------------------------------------------------
+/// Writes the type (and sequence) byte(s) and returns their size. outData must fit them.
+inline size_t WriteCompactMessageHeader(const MessageType messageType, const bool hasSequence, const uint16_t sequence, unsigned char* outData)
+{
+    outData[0] = static_cast<uint8_t>(messageType) | (hasSequence ? COMPACT_MESSAGE_SEQUENCE_FLAG : 0);
+    if (hasSequence)
+    {
+        outData[1] = static_cast<unsigned char>(sequence & 0xFF);
+        outData[2] = static_cast<unsigned char>(sequence >> 8);
+    }
+    
+    return hasSequence ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Returns the number of bytes written, or 0 if the message doesn't fit in outData. messageSize
+/// may be shorter than the struct for variable sized messages (ObjectStateDeltaUpdateMessage,
+/// and the packed messages of WriteMessage).
+inline size_t WriteCompactMessage(const void* message, const size_t messageSize, const bool hasSequence, const uint16_t sequence, unsigned char* outData, const size_t outDataCapacity)
+{
+    const auto* messageBytes = static_cast<const unsigned char*>(message);
+    const auto messageType = static_cast<MessageType>(messageBytes[0]);
+    const auto fieldsOffset = GetMessageFieldsOffset(messageType);
+    if (fieldsOffset == 0 || messageSize < fieldsOffset || messageSize > GetMessageSize(messageType))
+    {
+        return 0;
+    }
+    
+    const auto headerSize = hasSequence ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t);
+    const auto fieldsSize = messageSize - fieldsOffset;
+    if (headerSize + fieldsSize > outDataCapacity)
+    {
+        return 0;
+    }
+    
+    WriteCompactMessageHeader(messageType, hasSequence, sequence, outData);
+    std::memcpy(outData + headerSize, messageBytes + fieldsOffset, fieldsSize);
+    return headerSize + fieldsSize;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Typed version of the above. Variable length messages have their fields packed straight into
+/// outData (see WriteMessage).
+template<typename MessageT>
+inline size_t WriteCompactMessage(const MessageT& message, const bool hasSequence, const uint16_t sequence, unsigned char* outData, const size_t outDataCapacity)
+{
+    if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        const auto headerSize = hasSequence ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t);
+        const auto fieldsSize = message_serialization::GetPackedFieldsSize(message);
+        if (headerSize + fieldsSize > outDataCapacity || message_serialization::WritePackedFields(message, outData + headerSize) == 0)
+        {
+            return 0;
+        }
+        
+        WriteCompactMessageHeader(MessageT::MESSAGE_TYPE, hasSequence, sequence, outData);
+        return headerSize + fieldsSize;
+    }
+    else
+    {
+        return WriteCompactMessage(&message, GetMessageWireSize(message), hasSequence, sequence, outData, outDataCapacity);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename MessageT>
+inline size_t WriteCompactMessage(const MessageT& message, unsigned char* outData, const size_t outDataCapacity)
+{
+    return WriteCompactMessage(message, false, 0, outData, outDataCapacity);
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename MessageT>
+inline size_t WriteCompactMessage(const MessageT& message, const uint16_t sequence, unsigned char* outData, const size_t outDataCapacity)
+{
+    return WriteCompactMessage(message, true, sequence, outData, outDataCapacity);
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename MessageT>
+inline size_t GetCompactMessageSize(const MessageT& message, const bool hasSequence = false)
+{
+    return (hasSequence ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t)) + GetMessageWireSize(message) - GetMessageFieldsOffset(message.__header.type);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Rebuilds the full message struct (with the current version in its header) out of a compact
+/// message, so that the existing message handling can be used as is. outMessageSize is the size
+/// of the rebuilt message, which is only shorter than the struct for variable sized messages.
+inline bool ReadCompactMessage(const unsigned char* compactData, const size_t compactDataSize, unsigned char* outMessageData, const size_t outMessageCapacity, size_t& outMessageSize, bool& outHasSequence, uint16_t& outSequence)
+{
+    if (compactDataSize == 0)
+    {
+        return false;
+    }
+    
+    const auto messageType = static_cast<MessageType>(compactData[0] & ~COMPACT_MESSAGE_SEQUENCE_FLAG);
+    const auto messageSize = GetMessageSize(messageType);
+    const auto fieldsOffset = GetMessageFieldsOffset(messageType);
+    
+    outHasSequence = (compactData[0] & COMPACT_MESSAGE_SEQUENCE_FLAG) != 0;
+    const auto headerSize = outHasSequence ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t);
+    if (messageSize == 0 || compactDataSize < headerSize || messageSize > outMessageCapacity)
+    {
+        return false;
+    }
+    
+    // Only the delta updates and the packed variable length messages are allowed to be shorter than their struct
+    const auto fieldsSize = compactDataSize - headerSize;
+    const auto isVariableSize = messageType == MessageType::ObjectStateDeltaUpdateMessage || IsVariableLengthMessage(messageType);
+    if (fieldsSize > messageSize - fieldsOffset || (!isVariableSize && fieldsSize != messageSize - fieldsOffset))
+    {
+        return false;
+    }
+    
+    outSequence = outHasSequence ? static_cast<uint16_t>(compactData[1] | (compactData[2] << 8)) : 0;
+    
+    MessageHeader header { messageType, NET_COMMON_VERSION };
+    std::memset(outMessageData, 0, fieldsOffset);
+    std::memcpy(outMessageData, &header, sizeof(header));
+    std::memcpy(outMessageData + fieldsOffset, compactData + headerSize, fieldsSize);
+    outMessageSize = fieldsOffset + fieldsSize;
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename MessageT>
+inline bool ReadCompactMessage(const unsigned char* compactData, const size_t compactDataSize, MessageT& outMessage)
+{
+    if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        if (compactDataSize == 0 || (compactData[0] & ~COMPACT_MESSAGE_SEQUENCE_FLAG) != static_cast<uint8_t>(MessageT::MESSAGE_TYPE))
+        {
+            return false;
+        }
+        
+        const auto headerSize = (compactData[0] & COMPACT_MESSAGE_SEQUENCE_FLAG) != 0 ? COMPACT_MESSAGE_MAX_HEADER_SIZE : sizeof(uint8_t);
+        if (compactDataSize < headerSize)
+        {
+            return false;
+        }
+        
+        const MessageHeader header { MessageT::MESSAGE_TYPE, NET_COMMON_VERSION };
+        outMessage.__header = header;
+        return message_serialization::ReadPackedFields(compactData + headerSize, compactDataSize - headerSize, outMessage);
+    }
+    
+    size_t messageSize = 0;
+    bool hasSequence = false;
+    uint16_t sequence = 0;
+    return compactDataSize > 0 && (compactData[0] & ~COMPACT_MESSAGE_SEQUENCE_FLAG) == static_cast<uint8_t>(outMessage.__header.type) &&
+           ReadCompactMessage(compactData, compactDataSize, reinterpret_cast<unsigned char*>(&outMessage), sizeof(MessageT), messageSize, hasSequence, sequence) &&
+           messageSize == GetMessageWireSize(outMessage);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline MessageType GetCompactMessageType(const unsigned char* compactData)
+{
+    return static_cast<MessageType>(compactData[0] & ~COMPACT_MESSAGE_SEQUENCE_FLAG);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Per connection version handshake. The client sends a HandshakeRequestMessage (with the full
+/// header, so peers of any version can parse it) right after connecting, and the server answers
+/// with a HandshakeResponseMessage. Once both sides agreed on compact headers, all further
+/// traffic of that peer skips the per message version check and uses the compact format.
+class PeerHandshakeRegistry final
+{
+public:
+    static HandshakeRequestMessage CreateHandshakeRequest(const bool requestsCompactHeaders = true)
+    {
+        const auto& currentVersion = GetCurrentNetCommonVersion();
+        
+        HandshakeRequestMessage request;
+        request.versionMajor = currentVersion.major;
+        request.versionMinor = currentVersion.minor;
+        request.versionPatch = currentVersion.patch;
+        request.requestsCompactHeaders = requestsCompactHeaders;
+        return request;
+    }
+    
+    /// Server side. Fills in the response to send back to the peer (on the reliable channel), and
+    /// only registers the peer if its version is valid.
+    inline MessageVersionValidityEnum HandleHandshakeRequest(const ENetPeer* peer, const HandshakeRequestMessage& request, HandshakeResponseMessage& outResponse)
+    {
+        const auto& currentVersion = GetCurrentNetCommonVersion();
+        const auto versionValidity = GetVersionValidity(NetCommonVersion{ request.versionMajor, request.versionMinor, request.versionPatch });
+        const auto isValid = versionValidity == MessageVersionValidityEnum::VALID;
+        
+        outResponse = HandshakeResponseMessage();
+        outResponse.versionMajor = currentVersion.major;
+        outResponse.versionMinor = currentVersion.minor;
+        outResponse.versionPatch = currentVersion.patch;
+        outResponse.versionValidity = static_cast<uint8_t>(versionValidity);
+        outResponse.compactHeadersEnabled = isValid && request.requestsCompactHeaders;
+        
+        if (isValid)
+        {
+            mPeers[peer] = outResponse.compactHeadersEnabled;
+        }
+        else
+        {
+            mPeers.erase(peer);
+        }
+        
+        return versionValidity;
+    }
+    
+    /// Client side. The peer is the connection to the server.
+    inline MessageVersionValidityEnum HandleHandshakeResponse(const ENetPeer* peer, const HandshakeResponseMessage& response)
+    {
+        const auto versionValidity = GetVersionValidity(NetCommonVersion{ response.versionMajor, response.versionMinor, response.versionPatch });
+        if (versionValidity == MessageVersionValidityEnum::VALID && response.versionValidity == static_cast<uint8_t>(MessageVersionValidityEnum::VALID))
+        {
+            mPeers[peer] = response.compactHeadersEnabled;
+        }
+        else
+        {
+            mPeers.erase(peer);
+        }
+        
+        return versionValidity;
+    }
+    
+    inline bool IsPeerValidated(const ENetPeer* peer) const
+    {
+        return mPeers.count(peer) != 0;
+    }
+    
+    inline bool UsesCompactHeaders(const ENetPeer* peer) const
+    {
+        auto peerIter = mPeers.find(peer);
+        return peerIter != mPeers.end() && peerIter->second;
+    }
+    
+    /// To be called on disconnection, as ENet reuses its peer slots.
+    inline void RemovePeer(const ENetPeer* peer)
+    {
+        mPeers.erase(peer);
+    }
+
+private:
+    std::unordered_map<const ENetPeer*, bool> mPeers; // Validated peers, and whether they use compact headers
+};
+
+///------------------------------------------------------------------------------------------------
+/// Sends a message in whichever format was negotiated with the peer.
+template<typename MessageT>
+inline void SendPeerMessage(ENetPeer* toPeer, const MessageT& message, const enet_uint32 channel, const PeerHandshakeRegistry& handshakeRegistry)
+{
+    if (!handshakeRegistry.UsesCompactHeaders(toPeer))
+    {
+        SendMessage(toPeer, message, channel);
+        return;
+    }
+    
+    unsigned char compactData[COMPACT_MESSAGE_MAX_HEADER_SIZE + sizeof(MessageT)];
+    const auto compactDataSize = WriteCompactMessage(message, compactData, sizeof(compactData));
+    if (compactDataSize == 0)
+    {
+        // Malformed message (e.g. an array count over its capacity), don't send an empty packet
+        return;
+    }
+    
+    SendMessage(toPeer, compactData, compactDataSize, channel);
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // COMPACT_MESSAGES_H
@@ -0,0 +1,516 @@
+///------------------------------------------------------------------------------------------------
+///  CookedWorldAssets.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef COOKED_WORLD_ASSETS_H
+#define COOKED_WORLD_ASSETS_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/MapGlobalData.h>
+#include <net_common/Navmap.h>
+#include <net_common/PackedNavmap.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NET_COMMON_HAS_MMAP 1
+#else
+#include <fstream>
+#define NET_COMMON_HAS_MMAP 0
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* COOKED_WORLD_ASSETS_FILE_NAME = "world_assets.cooked";
+inline constexpr char COOKED_WORLD_MAGIC[8] = { 'T', 'M', 'M', 'O', 'W', 'R', 'L', 'D' };
+inline constexpr uint32_t COOKED_WORLD_FORMAT_VERSION = 2;
+inline constexpr uint32_t COOKED_WORLD_BYTE_ORDER_MARK = 0x01020304;
+inline constexpr size_t COOKED_WORLD_SECTION_ALIGNMENT = 64;
+inline constexpr int COOKED_MAP_NAME_CAPACITY = 32;
+inline constexpr int COOKED_MAX_NAVMAP_SIZE = 4096;
+inline constexpr int32_t NO_COOKED_MAP_INDEX = -1;
+
+///------------------------------------------------------------------------------------------------
+/// Layout of a cooked world blob, as written by CookWorldAssets (in the byte order of the host
+/// that cooked it, which the loader checks against its own):
+///
+///     CookedWorldHeader
+///     CookedMapRecord[mMapCount]           at mMapRecordsOffset
+///     per map, each section 64 byte aligned:
+///         navmap pixels                    RGBA, re-coloured with GetColorFromNavmapTileType
+///         SOLID row masks                  as in PackedNavmap::GetSolidRowMasks
+///         WATER row masks                  as in PackedNavmap::GetWaterRowMasks
+///
+/// Bump COOKED_WORLD_FORMAT_VERSION whenever any of the above changes, so that stale blobs
+/// are rejected rather than misread.
+struct CookedWorldHeader
+{
+    char mMagic[8];
+    uint32_t mFormatVersion;
+    uint32_t mByteOrderMark;
+    uint64_t mBlobSize;
+    uint32_t mMapCount;
+    uint32_t mMapRecordsOffset;
+    uint64_t mPayloadChecksum; // See ComputeCookedWorldChecksum
+};
+
+///------------------------------------------------------------------------------------------------
+
+struct CookedMapRecord
+{
+    char mMapName[COOKED_MAP_NAME_CAPACITY]; // Null terminated
+    float mPosition[2];
+    float mDimensions[2];
+    int32_t mConnectedMapIndices[static_cast<int>(MapConnectionDirection::COUNT)]; // NO_COOKED_MAP_INDEX if there is no connection
+    int32_t mNavmapSize;
+    uint32_t mPadding;
+    uint64_t mNavmapPixelsOffset;
+    uint64_t mSolidRowMasksOffset;
+    uint64_t mWaterRowMasksOffset;
+};
+
+static_assert(std::is_trivially_copyable<CookedWorldHeader>::value && sizeof(CookedWorldHeader) == 40, "CookedWorldHeader is written as is");
+static_assert(std::is_trivially_copyable<CookedMapRecord>::value && sizeof(CookedMapRecord) == 96, "CookedMapRecord is written as is");
+
+///------------------------------------------------------------------------------------------------
+/// 64 bit FNV-1a of every byte of the blob except those of mPayloadChecksum itself. The
+/// structural checks done at load can't tell flipped tile bits or map positions apart from real
+/// ones, this can.
+inline uint64_t ComputeCookedWorldChecksum(const unsigned char* blob, const size_t blobSize)
+{
+    constexpr auto CHECKSUM_OFFSET = offsetof(CookedWorldHeader, mPayloadChecksum);
+    constexpr auto CHECKSUM_END = CHECKSUM_OFFSET + sizeof(uint64_t);
+    
+    uint64_t checksum = 0xCBF29CE484222325;
+    for (size_t i = 0; i < blobSize; ++i)
+    {
+        if (i >= CHECKSUM_OFFSET && i < CHECKSUM_END)
+        {
+            continue;
+        }
+        
+        checksum = (checksum ^ blob[i]) * 0x100000001B3;
+    }
+    
+    return checksum;
+}
+
+///------------------------------------------------------------------------------------------------
+/// A decoded navmap to cook, e.g. straight out of the navmap png.
+struct CookedNavmapSource
+{
+    std::string mMapName;
+    const unsigned char* mNavmapPixels; // RGBA
+    int mNavmapSize;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Bakes the maps of mapGlobalData, along with their navmaps, into a single blob for
+/// CookedWorldAssets. Every map needs exactly one navmap source, and the other way around.
+/// Maps are stored in name order, so the same assets always cook into the same blob.
+/// Returns false (leaving outBlob empty) on missing or unknown maps, map names that don't
+/// fit in COOKED_MAP_NAME_CAPACITY, or bad navmap sizes.
+inline bool CookWorldAssets(const MapGlobalData& mapGlobalData, const std::vector<CookedNavmapSource>& navmapSources, std::vector<unsigned char>& outBlob)
+{
+    outBlob.clear();
+    if (navmapSources.size() != mapGlobalData.mMapDefinitions.size())
+    {
+        return false;
+    }
+    
+    std::vector<const CookedNavmapSource*> mapNavmapSources;
+    std::map<std::string, int32_t> mapIndices;
+    for (const auto& mapDefinitionEntry: mapGlobalData.mMapDefinitions)
+    {
+        const CookedNavmapSource* mapNavmapSource = nullptr;
+        for (const auto& navmapSource: navmapSources)
+        {
+            mapNavmapSource = navmapSource.mMapName == mapDefinitionEntry.first ? &navmapSource : mapNavmapSource;
+        }
+        
+        if (!mapNavmapSource || !mapNavmapSource->mNavmapPixels || mapNavmapSource->mNavmapSize <= 0 || mapNavmapSource->mNavmapSize > COOKED_MAX_NAVMAP_SIZE || mapDefinitionEntry.first.size() >= COOKED_MAP_NAME_CAPACITY)
+        {
+            return false;
+        }
+        
+        mapIndices[mapDefinitionEntry.first] = static_cast<int32_t>(mapNavmapSources.size());
+        mapNavmapSources.push_back(mapNavmapSource);
+    }
+    
+    auto alignOffset = [](const uint64_t offset){ return (offset + COOKED_WORLD_SECTION_ALIGNMENT - 1) & ~uint64_t(COOKED_WORLD_SECTION_ALIGNMENT - 1); };
+    
+    // Lay out the records and sections first, so that the blob is sized once
+    CookedWorldHeader header = {};
+    std::memcpy(header.mMagic, COOKED_WORLD_MAGIC, sizeof(header.mMagic));
+    header.mFormatVersion = COOKED_WORLD_FORMAT_VERSION;
+    header.mByteOrderMark = COOKED_WORLD_BYTE_ORDER_MARK;
+    header.mMapCount = static_cast<uint32_t>(mapNavmapSources.size());
+    header.mMapRecordsOffset = static_cast<uint32_t>(alignOffset(sizeof(CookedWorldHeader)));
+    
+    std::vector<CookedMapRecord> mapRecords(mapNavmapSources.size());
+    auto blobSize = alignOffset(header.mMapRecordsOffset + mapRecords.size() * sizeof(CookedMapRecord));
+    size_t mapIndex = 0;
+    for (const auto& mapDefinitionEntry: mapGlobalData.mMapDefinitions)
+    {
+        const auto& mapDefinition = mapDefinitionEntry.second;
+        const auto navmapSize = mapNavmapSources[mapIndex]->mNavmapSize;
+        const auto rowMaskWordCount = static_cast<uint64_t>((navmapSize + 63) / 64) * navmapSize;
+        
+        auto& mapRecord = mapRecords[mapIndex++];
+        mapRecord = {};
+        std::memcpy(mapRecord.mMapName, mapDefinitionEntry.first.c_str(), mapDefinitionEntry.first.size() + 1);
+        mapRecord.mPosition[0] = mapDefinition.mPosition.x;
+        mapRecord.mPosition[1] = mapDefinition.mPosition.y;
+        mapRecord.mDimensions[0] = mapDefinition.mDimensions.x;
+        mapRecord.mDimensions[1] = mapDefinition.mDimensions.y;
+        for (int i = 0; i < static_cast<int>(MapConnectionDirection::COUNT); ++i)
+        {
+            auto connectedMapIter = mapIndices.find(mapDefinition.mConnectedMaps[i]);
+            mapRecord.mConnectedMapIndices[i] = connectedMapIter == mapIndices.end() ? NO_COOKED_MAP_INDEX : connectedMapIter->second;
+        }
+        
+        mapRecord.mNavmapSize = navmapSize;
+        mapRecord.mNavmapPixelsOffset = blobSize;
+        mapRecord.mSolidRowMasksOffset = alignOffset(mapRecord.mNavmapPixelsOffset + static_cast<uint64_t>(navmapSize) * navmapSize * 4);
+        mapRecord.mWaterRowMasksOffset = alignOffset(mapRecord.mSolidRowMasksOffset + rowMaskWordCount * sizeof(uint64_t));
+        blobSize = alignOffset(mapRecord.mWaterRowMasksOffset + rowMaskWordCount * sizeof(uint64_t));
+    }
+    header.mBlobSize = blobSize;
+    
+    outBlob.assign(blobSize, 0);
+    std::memcpy(outBlob.data(), &header, sizeof(header));
+    std::memcpy(outBlob.data() + header.mMapRecordsOffset, mapRecords.data(), mapRecords.size() * sizeof(CookedMapRecord));
+    for (size_t i = 0; i < mapRecords.size(); ++i)
+    {
+        const auto& mapRecord = mapRecords[i];
+        const Navmap navmap(mapNavmapSources[i]->mNavmapPixels, mapRecord.mNavmapSize);
+        const PackedNavmap packedNavmap(navmap);
+        
+        // Pixels are re-coloured to the canonical colour of their tile type, so that anything
+        // the runtime doesn't classify on (e.g. editor tints) doesn't end up in the blob
+        auto* navmapPixels = outBlob.data() + mapRecord.mNavmapPixelsOffset;
+        for (int y = 0; y < mapRecord.mNavmapSize; ++y)
+        {
+            for (int x = 0; x < mapRecord.mNavmapSize; ++x)
+            {
+                const auto tileColor = GetColorFromNavmapTileType(packedNavmap.GetNavmapTileAt(glm::ivec2(x, y)));
+                auto* pixel = navmapPixels + (static_cast<size_t>(y) * mapRecord.mNavmapSize + x) * 4;
+                pixel[0] = static_cast<unsigned char>(tileColor.r);
+                pixel[1] = static_cast<unsigned char>(tileColor.g);
+                pixel[2] = static_cast<unsigned char>(tileColor.b);
+                pixel[3] = static_cast<unsigned char>(tileColor.a);
+            }
+        }
+        
+        std::memcpy(outBlob.data() + mapRecord.mSolidRowMasksOffset, packedNavmap.GetSolidRowMasks(), packedNavmap.GetRowMaskWordCount() * sizeof(uint64_t));
+        std::memcpy(outBlob.data() + mapRecord.mWaterRowMasksOffset, packedNavmap.GetWaterRowMasks(), packedNavmap.GetRowMaskWordCount() * sizeof(uint64_t));
+    }
+    
+    header.mPayloadChecksum = ComputeCookedWorldChecksum(outBlob.data(), outBlob.size());
+    std::memcpy(outBlob.data(), &header, sizeof(header));
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Writes to a temporary file next to filePath and then renames it over filePath, so that
+/// servers never map a half written blob. Servers that mapped the previous blob keep seeing
+/// it until they reload.
+inline bool WriteCookedWorldAssets(const std::string& filePath, const std::vector<unsigned char>& blob)
+{
+    const auto temporaryFilePath = filePath + ".tmp";
+    auto* file = std::fopen(temporaryFilePath.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+    
+    const auto isWritten = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    if (std::fclose(file) != 0 || !isWritten)
+    {
+        std::remove(temporaryFilePath.c_str());
+        return false;
+    }
+    
+    return std::rename(temporaryFilePath.c_str(), filePath.c_str()) == 0;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Read only, zero copy access to a cooked world blob. Files are mmap-ed where available, so
+/// loading only costs the validation of the header and map records (no navmap decoding), and
+/// the pages are shared by every server process on the host mapping the same file.
+///
+/// Navmap and PackedNavmap views point straight into the blob, so they must not outlive the
+/// loaded assets. Hot reloads load into a fresh CookedWorldAssets and swap it in (e.g. through
+/// a std::unique_ptr) once nothing uses the views of the old one.
+class CookedWorldAssets final
+{
+public:
+    CookedWorldAssets() = default;
+    ~CookedWorldAssets() { Unload(); }
+    
+    CookedWorldAssets(const CookedWorldAssets&) = delete;
+    CookedWorldAssets& operator = (const CookedWorldAssets&) = delete;
+    
+    /// Returns false, leaving the assets unloaded, if the file can't be read or isn't a valid
+    /// blob of this COOKED_WORLD_FORMAT_VERSION.
+    inline bool LoadFromFile(const std::string& filePath)
+    {
+        Unload();
+
+#if NET_COMMON_HAS_MMAP
+        const auto fileDescriptor = open(filePath.c_str(), O_RDONLY);
+        if (fileDescriptor == -1)
+        {
+            return false;
+        }
+        
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+        
+        // The mapping stays valid once the descriptor is closed. MAP_PRIVATE, as nothing is ever
+        // written through it; the untouched pages are still the page cache's, shared with the
+        // other servers. Neither mapping type survives the file being truncated, which is why
+        // WriteCookedWorldAssets renames a new file over the old one instead.
+        auto* mappedData = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor);
+        if (mappedData == MAP_FAILED)
+        {
+            return false;
+        }
+        
+        mMappedData = mappedData;
+        mMappedDataSize = static_cast<size_t>(fileStat.st_size);
+        mBlob = static_cast<const unsigned char*>(mappedData);
+        mBlobSize = mMappedDataSize;
+#else
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        
+        const auto fileSize = static_cast<size_t>(file.tellg());
+        mReadData.resize((fileSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(mReadData.data()), static_cast<std::streamsize>(fileSize)))
+        {
+            Unload();
+            return false;
+        }
+        
+        mBlob = reinterpret_cast<const unsigned char*>(mReadData.data());
+        mBlobSize = fileSize;
+#endif
+
+        if (!IsBlobValid())
+        {
+            Unload();
+            return false;
+        }
+        
+        return true;
+    }
+    
+    /// Non owning, e.g. for blobs embedded in the executable. The blob needs to be 8 byte
+    /// aligned and to outlive the assets.
+    inline bool LoadFromMemory(const void* blob, const size_t blobSize)
+    {
+        Unload();
+        if (!blob || reinterpret_cast<uintptr_t>(blob) % alignof(uint64_t) != 0)
+        {
+            return false;
+        }
+        
+        mBlob = static_cast<const unsigned char*>(blob);
+        mBlobSize = blobSize;
+        if (!IsBlobValid())
+        {
+            Unload();
+            return false;
+        }
+        
+        return true;
+    }
+    
+    inline void Unload()
+    {
+#if NET_COMMON_HAS_MMAP
+        if (mMappedData)
+        {
+            munmap(mMappedData, mMappedDataSize);
+        }
+        mMappedData = nullptr;
+        mMappedDataSize = 0;
+#else
+        mReadData.clear();
+        mReadData.shrink_to_fit();
+#endif
+        mBlob = nullptr;
+        mBlobSize = 0;
+    }
+    
+    /// Not part of loading, since it reads the whole blob. The cooker checks it before writing,
+    /// and servers can check it after loading from storage they don't trust.
+    inline bool IsChecksumValid() const
+    {
+        return mBlob && GetHeader().mPayloadChecksum == ComputeCookedWorldChecksum(mBlob, mBlobSize);
+    }
+    
+    inline bool IsLoaded() const { return mBlob != nullptr; }
+    inline size_t GetBlobSize() const { return mBlobSize; }
+    inline size_t GetMapCount() const { return mBlob ? GetHeader().mMapCount : 0; }
+    
+    inline const char* GetMapName(const size_t mapIndex) const { return GetMapRecord(mapIndex).mMapName; }
+    
+    /// NO_COOKED_MAP_INDEX if there is no such map.
+    inline int32_t FindMapIndex(const std::string& mapName) const
+    {
+        for (size_t i = 0; i < GetMapCount(); ++i)
+        {
+            if (mapName == GetMapRecord(i).mMapName)
+            {
+                return static_cast<int32_t>(i);
+            }
+        }
+        
+        return NO_COOKED_MAP_INDEX;
+    }
+    
+    /// NO_COOKED_MAP_INDEX if the map isn't connected in that direction.
+    inline int32_t GetConnectedMapIndex(const size_t mapIndex, const MapConnectionDirection direction) const
+    {
+        return GetMapRecord(mapIndex).mConnectedMapIndices[static_cast<int>(direction)];
+    }
+    
+    inline MapDefinition GetMapDefinition(const size_t mapIndex) const
+    {
+        const auto& mapRecord = GetMapRecord(mapIndex);
+        
+        MapDefinition mapDefinition;
+        mapDefinition.mPosition = glm::vec2(mapRecord.mPosition[0], mapRecord.mPosition[1]);
+        mapDefinition.mDimensions = glm::vec2(mapRecord.mDimensions[0], mapRecord.mDimensions[1]);
+        for (int i = 0; i < static_cast<int>(MapConnectionDirection::COUNT); ++i)
+        {
+            const auto connectedMapIndex = mapRecord.mConnectedMapIndices[i];
+            mapDefinition.mConnectedMaps[i] = connectedMapIndex == NO_COOKED_MAP_INDEX ? std::string() : std::string(GetMapRecord(static_cast<size_t>(connectedMapIndex)).mMapName);
+        }
+        
+        return mapDefinition;
+    }
+    
+    /// Same contents as ParseMapGlobalData would give for the cooked map_global_data.json.
+    inline void GetMapGlobalData(MapGlobalData& outMapGlobalData) const
+    {
+        outMapGlobalData.mMapDefinitions.clear();
+        for (size_t i = 0; i < GetMapCount(); ++i)
+        {
+            outMapGlobalData.mMapDefinitions[GetMapName(i)] = GetMapDefinition(i);
+        }
+    }
+    
+    inline Navmap GetNavmap(const size_t mapIndex) const
+    {
+        const auto& mapRecord = GetMapRecord(mapIndex);
+        return Navmap(mBlob + mapRecord.mNavmapPixelsOffset, mapRecord.mNavmapSize);
+    }
+    
+    inline PackedNavmap GetPackedNavmap(const size_t mapIndex) const
+    {
+        const auto& mapRecord = GetMapRecord(mapIndex);
+        return PackedNavmap(reinterpret_cast<const uint64_t*>(mBlob + mapRecord.mSolidRowMasksOffset), reinterpret_cast<const uint64_t*>(mBlob + mapRecord.mWaterRowMasksOffset), mapRecord.mNavmapSize);
+    }
+
+private:
+    inline const CookedWorldHeader& GetHeader() const { return *reinterpret_cast<const CookedWorldHeader*>(mBlob); }
+    inline const CookedMapRecord& GetMapRecord(const size_t mapIndex) const { return reinterpret_cast<const CookedMapRecord*>(mBlob + GetHeader().mMapRecordsOffset)[mapIndex]; }
+    
+    inline bool IsSectionInBlob(const uint64_t offset, const uint64_t size) const
+    {
+        return offset % COOKED_WORLD_SECTION_ALIGNMENT == 0 && offset <= mBlobSize && size <= mBlobSize - offset;
+    }
+    
+    /// Checks everything the accessors rely on, so that a truncated, stale or corrupt blob is
+    /// rejected at load rather than read out of bounds later on.
+    inline bool IsBlobValid() const
+    {
+        if (mBlobSize < sizeof(CookedWorldHeader))
+        {
+            return false;
+        }
+        
+        const auto& header = GetHeader();
+        if (std::memcmp(header.mMagic, COOKED_WORLD_MAGIC, sizeof(header.mMagic)) != 0 || header.mFormatVersion != COOKED_WORLD_FORMAT_VERSION ||
+            header.mByteOrderMark != COOKED_WORLD_BYTE_ORDER_MARK || header.mBlobSize != mBlobSize ||
+            !IsSectionInBlob(header.mMapRecordsOffset, static_cast<uint64_t>(header.mMapCount) * sizeof(CookedMapRecord)))
+        {
+            return false;
+        }
+        
+        for (size_t i = 0; i < header.mMapCount; ++i)
+        {
+            const auto& mapRecord = GetMapRecord(i);
+            if (std::memchr(mapRecord.mMapName, '\0', COOKED_MAP_NAME_CAPACITY) == nullptr || mapRecord.mNavmapSize <= 0 || mapRecord.mNavmapSize > COOKED_MAX_NAVMAP_SIZE)
+            {
+                return false;
+            }
+            
+            for (const auto connectedMapIndex: mapRecord.mConnectedMapIndices)
+            {
+                if (connectedMapIndex != NO_COOKED_MAP_INDEX && (connectedMapIndex < 0 || static_cast<uint32_t>(connectedMapIndex) >= header.mMapCount))
+                {
+                    return false;
+                }
+            }
+            
+            const auto rowMaskBytes = static_cast<uint64_t>((mapRecord.mNavmapSize + 63) / 64) * mapRecord.mNavmapSize * sizeof(uint64_t);
+            if (!IsSectionInBlob(mapRecord.mNavmapPixelsOffset, static_cast<uint64_t>(mapRecord.mNavmapSize) * mapRecord.mNavmapSize * 4) ||
+                !IsSectionInBlob(mapRecord.mSolidRowMasksOffset, rowMaskBytes) ||
+                !IsSectionInBlob(mapRecord.mWaterRowMasksOffset, rowMaskBytes))
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+
+private:
+    const unsigned char* mBlob = nullptr;
+    size_t mBlobSize = 0;
+#if NET_COMMON_HAS_MMAP
+    void* mMappedData = nullptr;
+    size_t mMappedDataSize = 0;
+#else
+    std::vector<uint64_t> mReadData; // uint64_t for the alignment of the row masks
+#endif
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // COOKED_WORLD_ASSETS_H
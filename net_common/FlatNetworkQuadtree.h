@@ -0,0 +1,113 @@
+///------------------------------------------------------------------------------------------------
+///  FlatNetworkQuadtree.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef FlatNetworkQuadtree_h
+#define FlatNetworkQuadtree_h
+
+///------------------------------------------------------------------------------------------------
+
+#if __has_include(<engine/utils/MathUtils.h>)
+#include <engine/utils/MathUtils.h>
+#else
+#include "../util/MathUtils.h"
+#endif
+
+#include <net_common/NetworkCommon.h>
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/ObjectTable.h>
+#include <algorithm>
+#include <vector>
+
+///-----------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///-----------------------------------------------------------------------------------------------
+/// Alternative to the NetworkQuadtree with the same splitting rules and query results, but
+/// with all nodes living in one contiguous array (children of a node are always 4 consecutive
+/// nodes) and all entries living in one buffer, sorted by node so that every node's entries
+/// (and every subtree's) are a contiguous range. The splits only depend on how many entries
+/// fit in each node and not on the insertion order, so the nodes are rebuilt top down from
+/// scratch, with one stable counting sort of each split node's range into its 4 children.
+/// Clear() only resets the sizes of the buffers, so once warmed up the usual
+/// Clear + PopulateSceneGraph cycle doesn't allocate at all.
+class FlatNetworkQuadtree final
+{
+public:
+    FlatNetworkQuadtree(const glm::vec3& origin, const glm::vec3& dimensions, const int maxObjectsPerNode = MAX_OBJECTS_PER_NODE, const int maxDepth = MAX_DEPTH);
+    
+    const glm::vec3& GetOrigin() const;
+    const glm::vec3& GetDimensions() const;
+    std::vector<objectId_t> GetCollisionCandidates(const ObjectData& objectData) const;
+    void GetCollisionCandidates(const ObjectData& objectData, std::vector<objectId_t>& outCollisionCandidates) const;
+    
+    // As with the NetworkQuadtree, an inserted object is visible to queries straight away. Since
+    // that rebuilds all nodes, bulk inserts should instead go through StageObject, which only
+    // stages the object, followed by a single CommitStagedObjects (PopulateSceneGraph does both).
+    void InsertObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions);
+    void StageObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions);
+    void CommitStagedObjects();
+    void PopulateSceneGraph(const std::vector<ObjectData>& netObjectData);
+    void PopulateSceneGraph(const ObjectTable& objectTable);
+    void Clear();
+    
+    void GetObjectsInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, std::vector<objectId_t>& outObjectIds) const;
+    void GetObjectsInRadius(const glm::vec3& center, const float radius, std::vector<objectId_t>& outObjectIds) const;
+    
+    std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugRenderRectangles() const;
+    size_t GetNodeCount() const;
+    size_t GetObjectCount() const;
+
+private:
+    static constexpr int INVALID_INDEX = -1;
+    
+    struct QuadtreeNode
+    {
+        glm::vec3 mOrigin;
+        glm::vec3 mDimensions;
+        int mDepth;
+        int mFirstChildIndex;
+        int mFirstEntryIndex;
+        int mEntryCount;
+    };
+    
+    struct QuadtreeEntityEntry
+    {
+        objectId_t mObjectId;
+        glm::vec3 mObjectPosition;
+        glm::vec3 mObjectDimensions;
+    };
+    
+    int GetMatchedQuadrant(const QuadtreeNode& node, const glm::vec3& objectPosition, const glm::vec3& objectDimensions) const;
+    void InternalBuildNode(const int nodeIndex, const int firstEntryIndex, const int entryCount);
+    void InternalGetCollisionCandidates(const int nodeIndex, const glm::vec3& position, const glm::vec3& colliderDimensions, std::vector<objectId_t>& collisionCandidates) const;
+    template<typename OverlapPredicateT>
+    void InternalGetObjectsInRegion(const int nodeIndex, const glm::vec2& regionMin, const glm::vec2& regionMax, OverlapPredicateT& overlapPredicate, std::vector<objectId_t>& outObjectIds) const;
+    void InternalGetDebugRenderRectangles(const int nodeIndex, std::vector<std::pair<glm::vec3, glm::vec3>>& debugRectangles) const;
+    void Split(const int nodeIndex);
+
+private:
+    const glm::vec3 mOrigin;
+    const glm::vec3 mDimensions;
+    const int mMaxObjectsPerNode;
+    const int mMaxDepth;
+    
+    std::vector<QuadtreeNode> mNodes;
+    std::vector<QuadtreeEntityEntry> mStagedEntries;  // Every object inserted since the last Clear, committed or not
+    std::vector<QuadtreeEntityEntry> mEntries;        // Sorted by node, each node's range followed by its children's
+    std::vector<objectId_t> mEntryObjectIds;          // Object ids of mEntries, for the candidate queries
+    std::vector<QuadtreeEntityEntry> mSortedEntries;  // Counting sort scratch
+    std::vector<uint8_t> mEntryBuckets;               // Counting sort scratch: 0 for straddling entries, 1 + quadrant otherwise
+};
+
+///------------------------------------------------------------------------------------------------
+
+#include "FlatNetworkQuadtree.inc"
+
+};
+#endif /* FlatNetworkQuadtree_h */
@@ -0,0 +1,162 @@
+///------------------------------------------------------------------------------------------------
+///  InterestManager.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef INTEREST_MANAGER_H
+#define INTEREST_MANAGER_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/MessageFrame.h>
+#include <net_common/NetworkQuadtree.h>
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+struct InterestUpdate
+{
+    std::vector<objectId_t> mEnteredObjectIds;
+    std::vector<objectId_t> mLeftObjectIds;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Area of interest bookkeeping on top of the NetworkQuadtree range queries.
+/// Every viewer (typically a connected player's object) keeps a sorted set of visible
+/// objects. Objects enter the set within the view radius and only leave it once they are
+/// further than viewRadius + leaveMargin, so that objects on the boundary don't flicker
+/// in and out every tick.
+class InterestManager final
+{
+public:
+    InterestManager(const float viewRadius, const float leaveMargin)
+    : mViewRadius(viewRadius)
+    , mLeaveRadius(viewRadius + leaveMargin)
+    {
+    }
+    
+    /// Recomputes the visible set of the viewer against the current state of the quadtree
+    /// and fills outUpdate with the objects that entered and left it since the last update.
+    inline void UpdateViewerInterest(const objectId_t viewerId, const glm::vec3& viewCenter, const NetworkQuadtree& quadtree, InterestUpdate& outUpdate)
+    {
+        outUpdate.mEnteredObjectIds.clear();
+        outUpdate.mLeftObjectIds.clear();
+        
+        auto& previouslyVisible = mViewerVisibleObjects[viewerId];
+        auto& currentlyVisible = mScratchVisibleObjects;
+        currentlyVisible.clear();
+        
+        const auto viewRadiusSquared = mViewRadius * mViewRadius;
+        quadtree.ForEachObjectInRadius(viewCenter, mLeaveRadius, [&](const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+        {
+            // The viewer's own object is never streamed to it as an enter/leave event
+            if (objectId == viewerId)
+            {
+                return;
+            }
+            
+            const auto dx = math::Max(0.0f, std::abs(viewCenter.x - position.x) - dimensions.x * 0.5f);
+            const auto dy = math::Max(0.0f, std::abs(viewCenter.y - position.y) - dimensions.y * 0.5f);
+            if (dx * dx + dy * dy <= viewRadiusSquared || std::binary_search(previouslyVisible.begin(), previouslyVisible.end(), objectId))
+            {
+                currentlyVisible.push_back(objectId);
+            }
+        });
+        
+        std::sort(currentlyVisible.begin(), currentlyVisible.end());
+        currentlyVisible.erase(std::unique(currentlyVisible.begin(), currentlyVisible.end()), currentlyVisible.end());
+        
+        std::set_difference(currentlyVisible.begin(), currentlyVisible.end(), previouslyVisible.begin(), previouslyVisible.end(), std::back_inserter(outUpdate.mEnteredObjectIds));
+        std::set_difference(previouslyVisible.begin(), previouslyVisible.end(), currentlyVisible.begin(), currentlyVisible.end(), std::back_inserter(outUpdate.mLeftObjectIds));
+        
+        // Swap rather than copy so that both buffers keep their capacity across ticks
+        previouslyVisible.swap(currentlyVisible);
+    }
+    
+    inline const std::vector<objectId_t>& GetVisibleObjects(const objectId_t viewerId) const
+    {
+        static const std::vector<objectId_t> EMPTY_VISIBLE_OBJECTS;
+        
+        auto viewerIter = mViewerVisibleObjects.find(viewerId);
+        return viewerIter == mViewerVisibleObjects.end() ? EMPTY_VISIBLE_OBJECTS : viewerIter->second;
+    }
+    
+    inline bool IsObjectVisibleToViewer(const objectId_t viewerId, const objectId_t objectId) const
+    {
+        const auto& visibleObjects = GetVisibleObjects(viewerId);
+        return std::binary_search(visibleObjects.begin(), visibleObjects.end(), objectId);
+    }
+    
+    inline void RemoveViewer(const objectId_t viewerId)
+    {
+        mViewerVisibleObjects.erase(viewerId);
+    }
+    
+    /// To be called when an object is destroyed, so that it doesn't produce a
+    /// leave event on top of the destruction the server already sends.
+    inline void RemoveObject(const objectId_t objectId)
+    {
+        for (auto& viewerEntry: mViewerVisibleObjects)
+        {
+            auto& visibleObjects = viewerEntry.second;
+            auto objectIter = std::lower_bound(visibleObjects.begin(), visibleObjects.end(), objectId);
+            if (objectIter != visibleObjects.end() && *objectIter == objectId)
+            {
+                visibleObjects.erase(objectIter);
+            }
+        }
+    }
+    
+    inline float GetViewRadius() const { return mViewRadius; }
+    inline float GetLeaveRadius() const { return mLeaveRadius; }
+
+private:
+    const float mViewRadius;
+    const float mLeaveRadius;
+    std::unordered_map<objectId_t, std::vector<objectId_t>> mViewerVisibleObjects;
+    std::vector<objectId_t> mScratchVisibleObjects;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Maps an interest update onto the existing protocol: entering objects are sent as
+/// ObjectCreatedMessages and leaving ones as ObjectDestroyedMessages, both reliably.
+/// objectLookup: const ObjectData*(const objectId_t objectId), nullptr for unknown objects.
+template<typename ObjectLookupT>
+inline void QueueInterestUpdateMessages(const InterestUpdate& interestUpdate, ObjectLookupT&& objectLookup, PeerMessageFrameBatcher& batcher)
+{
+    for (const auto objectId: interestUpdate.mEnteredObjectIds)
+    {
+        const ObjectData* objectData = objectLookup(objectId);
+        if (objectData)
+        {
+            ObjectCreatedMessage objectCreatedMessage;
+            objectCreatedMessage.objectData = *objectData;
+            batcher.QueueMessage(objectCreatedMessage, channels::RELIABLE);
+        }
+    }
+    
+    for (const auto objectId: interestUpdate.mLeftObjectIds)
+    {
+        ObjectDestroyedMessage objectDestroyedMessage;
+        objectDestroyedMessage.objectId = objectId;
+        batcher.QueueMessage(objectDestroyedMessage, channels::RELIABLE);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // INTEREST_MANAGER_H
@@ -0,0 +1,226 @@
+///------------------------------------------------------------------------------------------------
+///  JobPool.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// Small fork/join pool for data parallel loops. ParallelFor splits the items evenly across the
+/// threads up front, and threads that run out of items steal half of the remaining range of
+/// another thread, so that uneven items (e.g. quadtree nodes) still balance out. The calling
+/// thread takes part as thread 0 and ParallelFor returns once every item has run.
+///
+/// Only one ParallelFor may run at a time, and jobs must not call ParallelFor themselves.
+class JobPool final
+{
+public:
+    /// threadCount includes the calling thread, and 0 picks the hardware concurrency.
+    JobPool(const size_t threadCount = 0)
+    : mThreadCount(threadCount != 0 ? threadCount : static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())))
+    , mThreadRanges(std::make_unique<ThreadRange[]>(mThreadCount))
+    , mGeneration(0)
+    , mActiveWorkerCount(0)
+    , mIsShuttingDown(false)
+    , mJobFunction(nullptr)
+    , mJobContext(nullptr)
+    {
+        for (size_t threadIndex = 1; threadIndex < mThreadCount; ++threadIndex)
+        {
+            mWorkers.emplace_back([this, threadIndex](){ WorkerLoop(threadIndex); });
+        }
+    }
+    
+    ~JobPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIsShuttingDown = true;
+        }
+        
+        mStartCondition.notify_all();
+        for (auto& worker: mWorkers)
+        {
+            worker.join();
+        }
+    }
+    
+    JobPool(const JobPool&) = delete;
+    JobPool& operator = (const JobPool&) = delete;
+    
+    inline size_t GetThreadCount() const { return mThreadCount; }
+    
+    /// Calls job(threadIndex, itemIndex) for every item in [0, itemCount), with itemCount below
+    /// 2^32. threadIndex is in [0, GetThreadCount()), and can be used to index per thread
+    /// buffers without locking.
+    template<typename JobT>
+    inline void ParallelFor(const size_t itemCount, JobT&& job)
+    {
+        if (itemCount == 0)
+        {
+            return;
+        }
+        
+        if (mThreadCount == 1 || itemCount == 1)
+        {
+            for (size_t itemIndex = 0; itemIndex < itemCount; ++itemIndex)
+            {
+                job(size_t(0), itemIndex);
+            }
+            return;
+        }
+        
+        for (size_t threadIndex = 0; threadIndex < mThreadCount; ++threadIndex)
+        {
+            mThreadRanges[threadIndex].mRange.store(PackRange(itemCount * threadIndex / mThreadCount, itemCount * (threadIndex + 1) / mThreadCount), std::memory_order_relaxed);
+        }
+        
+        using JobType = std::remove_reference_t<JobT>;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJobContext = const_cast<void*>(static_cast<const void*>(&job));
+            mJobFunction = [](void* jobContext, const size_t threadIndex, const size_t itemIndex){ (*static_cast<JobType*>(jobContext))(threadIndex, itemIndex); };
+            mActiveWorkerCount = mThreadCount - 1;
+            mGeneration++;
+        }
+        
+        mStartCondition.notify_all();
+        RunItems(0);
+        
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [this](){ return mActiveWorkerCount == 0; });
+        mJobFunction = nullptr;
+        mJobContext = nullptr;
+    }
+
+private:
+    using JobFunction = void(*)(void*, const size_t, const size_t);
+    
+    // [begin, end) packed in a single word, so that owners and thieves can update it with one CAS
+    struct alignas(64) ThreadRange
+    {
+        std::atomic<uint64_t> mRange { 0 };
+    };
+    
+    static inline uint64_t PackRange(const uint64_t begin, const uint64_t end) { return (begin << 32) | end; }
+    static inline uint64_t GetRangeBegin(const uint64_t range) { return range >> 32; }
+    static inline uint64_t GetRangeEnd(const uint64_t range) { return range & 0xFFFFFFFFull; }
+    
+    inline void WorkerLoop(const size_t threadIndex)
+    {
+        uint64_t lastGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStartCondition.wait(lock, [&](){ return mIsShuttingDown || mGeneration != lastGeneration; });
+                if (mIsShuttingDown)
+                {
+                    return;
+                }
+                
+                lastGeneration = mGeneration;
+            }
+            
+            RunItems(threadIndex);
+            
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mActiveWorkerCount == 0)
+            {
+                mDoneCondition.notify_one();
+            }
+        }
+    }
+    
+    inline void RunItems(const size_t threadIndex)
+    {
+        size_t itemIndex = 0;
+        while (PopItem(threadIndex, itemIndex) || StealItem(threadIndex, itemIndex))
+        {
+            mJobFunction(mJobContext, threadIndex, itemIndex);
+        }
+    }
+    
+    inline bool PopItem(const size_t threadIndex, size_t& outItemIndex)
+    {
+        auto& threadRange = mThreadRanges[threadIndex].mRange;
+        auto range = threadRange.load(std::memory_order_relaxed);
+        while (GetRangeBegin(range) < GetRangeEnd(range))
+        {
+            if (threadRange.compare_exchange_weak(range, PackRange(GetRangeBegin(range) + 1, GetRangeEnd(range)), std::memory_order_relaxed))
+            {
+                outItemIndex = static_cast<size_t>(GetRangeBegin(range));
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    /// Takes the upper half of the first non empty range after this thread's, running its first
+    /// item right away and keeping the rest as this thread's new range.
+    inline bool StealItem(const size_t threadIndex, size_t& outItemIndex)
+    {
+        for (size_t i = 1; i < mThreadCount; ++i)
+        {
+            auto& victimRange = mThreadRanges[(threadIndex + i) % mThreadCount].mRange;
+            auto range = victimRange.load(std::memory_order_relaxed);
+            while (GetRangeBegin(range) < GetRangeEnd(range))
+            {
+                const auto begin = GetRangeBegin(range);
+                const auto end = GetRangeEnd(range);
+                const auto stealBegin = begin + (end - begin) / 2;
+                if (victimRange.compare_exchange_weak(range, PackRange(begin, stealBegin), std::memory_order_relaxed))
+                {
+                    mThreadRanges[threadIndex].mRange.store(PackRange(stealBegin + 1, end), std::memory_order_relaxed);
+                    outItemIndex = static_cast<size_t>(stealBegin);
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
+
+private:
+    const size_t mThreadCount;
+    std::unique_ptr<ThreadRange[]> mThreadRanges;
+    std::vector<std::thread> mWorkers;
+    std::mutex mMutex;
+    std::condition_variable mStartCondition;
+    std::condition_variable mDoneCondition;
+    uint64_t mGeneration;
+    size_t mActiveWorkerCount;
+    bool mIsShuttingDown;
+    JobFunction mJobFunction;
+    void* mJobContext;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // JOB_POOL_H
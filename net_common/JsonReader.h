@@ -0,0 +1,328 @@
+///------------------------------------------------------------------------------------------------
+///  JsonReader.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+enum class JsonValueType
+{
+    NUL,
+    BOOLEAN,
+    NUMBER,
+    STRING,
+    ARRAY,
+    OBJECT
+};
+
+///------------------------------------------------------------------------------------------------
+/// Minimal DOM for the small asset/config files net_common needs to read (no dependencies).
+/// Object members keep their file order.
+struct JsonValue
+{
+    JsonValueType mType = JsonValueType::NUL;
+    bool mBoolean = false;
+    double mNumber = 0.0;
+    std::string mString;
+    std::vector<JsonValue> mArray;
+    std::vector<std::pair<std::string, JsonValue>> mObject;
+    
+    /// Returns nullptr if this is not an object or it has no such member.
+    inline const JsonValue* FindMember(const std::string& key) const
+    {
+        for (const auto& member: mObject)
+        {
+            if (member.first == key)
+            {
+                return &member.second;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    inline double GetNumberMember(const std::string& key, const double defaultValue) const
+    {
+        const auto* member = FindMember(key);
+        return member && member->mType == JsonValueType::NUMBER ? member->mNumber : defaultValue;
+    }
+    
+    inline std::string GetStringMember(const std::string& key, const std::string& defaultValue) const
+    {
+        const auto* member = FindMember(key);
+        return member && member->mType == JsonValueType::STRING ? member->mString : defaultValue;
+    }
+};
+
+///------------------------------------------------------------------------------------------------
+/// Recursive descent parser for standard JSON. \u escapes outside of ASCII are not decoded
+/// (they are kept verbatim), which is fine for the asset names and numbers we read.
+class JsonReader final
+{
+public:
+    /// Returns false on malformed input or trailing garbage.
+    static inline bool Parse(const std::string& jsonContents, JsonValue& outValue)
+    {
+        JsonReader reader(jsonContents);
+        outValue = JsonValue();
+        
+        if (!reader.ParseValue(outValue, 0))
+        {
+            return false;
+        }
+        
+        reader.SkipWhitespace();
+        return reader.mReadOffset == jsonContents.size();
+    }
+
+private:
+    static constexpr int MAX_NESTING_DEPTH = 64;
+    
+    JsonReader(const std::string& jsonContents)
+    : mContents(jsonContents)
+    , mReadOffset(0)
+    {
+    }
+    
+    inline void SkipWhitespace()
+    {
+        while (mReadOffset < mContents.size() && (mContents[mReadOffset] == ' ' || mContents[mReadOffset] == '\t' || mContents[mReadOffset] == '\n' || mContents[mReadOffset] == '\r'))
+        {
+            mReadOffset++;
+        }
+    }
+    
+    inline bool ConsumeLiteral(const char* literal)
+    {
+        const std::string literalString(literal);
+        if (mContents.compare(mReadOffset, literalString.size(), literalString) != 0)
+        {
+            return false;
+        }
+        
+        mReadOffset += literalString.size();
+        return true;
+    }
+    
+    inline bool ParseValue(JsonValue& outValue, const int depth)
+    {
+        SkipWhitespace();
+        if (mReadOffset >= mContents.size() || depth > MAX_NESTING_DEPTH)
+        {
+            return false;
+        }
+        
+        switch (mContents[mReadOffset])
+        {
+            case '{': return ParseObject(outValue, depth);
+            case '[': return ParseArray(outValue, depth);
+            case '"': outValue.mType = JsonValueType::STRING; return ParseString(outValue.mString);
+            case 't': outValue.mType = JsonValueType::BOOLEAN; outValue.mBoolean = true; return ConsumeLiteral("true");
+            case 'f': outValue.mType = JsonValueType::BOOLEAN; outValue.mBoolean = false; return ConsumeLiteral("false");
+            case 'n': outValue.mType = JsonValueType::NUL; return ConsumeLiteral("null");
+            default: break;
+        }
+        
+        return ParseNumber(outValue);
+    }
+    
+    inline bool ParseObject(JsonValue& outValue, const int depth)
+    {
+        outValue.mType = JsonValueType::OBJECT;
+        mReadOffset++;
+        
+        SkipWhitespace();
+        if (mReadOffset < mContents.size() && mContents[mReadOffset] == '}')
+        {
+            mReadOffset++;
+            return true;
+        }
+        
+        while (true)
+        {
+            SkipWhitespace();
+            
+            std::pair<std::string, JsonValue> member;
+            if (mReadOffset >= mContents.size() || mContents[mReadOffset] != '"' || !ParseString(member.first))
+            {
+                return false;
+            }
+            
+            SkipWhitespace();
+            if (mReadOffset >= mContents.size() || mContents[mReadOffset] != ':')
+            {
+                return false;
+            }
+            
+            mReadOffset++;
+            if (!ParseValue(member.second, depth + 1))
+            {
+                return false;
+            }
+            
+            outValue.mObject.push_back(std::move(member));
+            
+            SkipWhitespace();
+            if (mReadOffset >= mContents.size())
+            {
+                return false;
+            }
+            
+            if (mContents[mReadOffset++] == '}')
+            {
+                return true;
+            }
+            
+            if (mContents[mReadOffset - 1] != ',')
+            {
+                return false;
+            }
+        }
+    }
+    
+    inline bool ParseArray(JsonValue& outValue, const int depth)
+    {
+        outValue.mType = JsonValueType::ARRAY;
+        mReadOffset++;
+        
+        SkipWhitespace();
+        if (mReadOffset < mContents.size() && mContents[mReadOffset] == ']')
+        {
+            mReadOffset++;
+            return true;
+        }
+        
+        while (true)
+        {
+            JsonValue element;
+            if (!ParseValue(element, depth + 1))
+            {
+                return false;
+            }
+            
+            outValue.mArray.push_back(std::move(element));
+            
+            SkipWhitespace();
+            if (mReadOffset >= mContents.size())
+            {
+                return false;
+            }
+            
+            if (mContents[mReadOffset++] == ']')
+            {
+                return true;
+            }
+            
+            if (mContents[mReadOffset - 1] != ',')
+            {
+                return false;
+            }
+        }
+    }
+    
+    inline bool ParseString(std::string& outString)
+    {
+        mReadOffset++;
+        outString.clear();
+        
+        while (mReadOffset < mContents.size())
+        {
+            const auto character = mContents[mReadOffset++];
+            if (character == '"')
+            {
+                return true;
+            }
+            
+            if (character != '\\')
+            {
+                outString.push_back(character);
+                continue;
+            }
+            
+            if (mReadOffset >= mContents.size())
+            {
+                return false;
+            }
+            
+            const auto escapedCharacter = mContents[mReadOffset++];
+            switch (escapedCharacter)
+            {
+                case '"': outString.push_back('"'); break;
+                case '\\': outString.push_back('\\'); break;
+                case '/': outString.push_back('/'); break;
+                case 'b': outString.push_back('\b'); break;
+                case 'f': outString.push_back('\f'); break;
+                case 'n': outString.push_back('\n'); break;
+                case 'r': outString.push_back('\r'); break;
+                case 't': outString.push_back('\t'); break;
+                case 'u':
+                {
+                    if (mReadOffset + 4 > mContents.size())
+                    {
+                        return false;
+                    }
+                    
+                    const auto codePoint = std::strtol(mContents.substr(mReadOffset, 4).c_str(), nullptr, 16);
+                    if (codePoint < 0x80)
+                    {
+                        outString.push_back(static_cast<char>(codePoint));
+                    }
+                    else
+                    {
+                        outString.append(mContents, mReadOffset - 2, 6);
+                    }
+                    
+                    mReadOffset += 4;
+                } break;
+                default: return false;
+            }
+        }
+        
+        return false;
+    }
+    
+    inline bool ParseNumber(JsonValue& outValue)
+    {
+        const char* numberStart = mContents.c_str() + mReadOffset;
+        char* numberEnd = nullptr;
+        outValue.mType = JsonValueType::NUMBER;
+        outValue.mNumber = std::strtod(numberStart, &numberEnd);
+        
+        if (numberEnd == numberStart)
+        {
+            return false;
+        }
+        
+        mReadOffset += static_cast<size_t>(numberEnd - numberStart);
+        return true;
+    }
+
+private:
+    const std::string& mContents;
+    size_t mReadOffset;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // JSON_READER_H
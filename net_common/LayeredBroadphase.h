@@ -0,0 +1,175 @@
+///------------------------------------------------------------------------------------------------
+///  LayeredBroadphase.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef LAYERED_BROADPHASE_H
+#define LAYERED_BROADPHASE_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/ObjectTable.h>
+#include <net_common/StaticObjectLayer.h>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// Two layer broadphase: ObjectType::STATIC objects go in a StaticObjectLayer built once per map
+/// load, and everything that moves goes in a NetworkQuadtree rebuilt every tick as usual, which
+/// then only pays for the movers.
+///
+///     broadphase.BuildStaticLayer(mapObjects);       // On map load
+///     ...
+///     broadphase.Clear();                            // Every tick, only clears the dynamic layer
+///     broadphase.PopulateSceneGraph(objects);
+///
+/// Queries go through both layers, and report objects of both the same way.
+class LayeredBroadphase final
+{
+public:
+    LayeredBroadphase(const glm::vec3& origin, const glm::vec3& dimensions)
+    : mDynamicLayer(origin, dimensions)
+    {
+    }
+    
+    inline const glm::vec3& GetOrigin() const { return mDynamicLayer.GetOrigin(); }
+    inline const glm::vec3& GetDimensions() const { return mDynamicLayer.GetDimensions(); }
+    inline const StaticObjectLayer& GetStaticLayer() const { return mStaticLayer; }
+    inline const NetworkQuadtree& GetDynamicLayer() const { return mDynamicLayer; }
+    
+    /// Only the STATIC objects of netObjectData are taken, so the whole map can be passed in.
+    inline void BuildStaticLayer(const std::vector<ObjectData>& netObjectData)
+    {
+        mStaticLayer.Build(netObjectData);
+    }
+    
+    /// STATIC objects are skipped, as they already are in the static layer. Object indices
+    /// refer to netObjectData as with NetworkQuadtree::PopulateSceneGraph.
+    inline void PopulateSceneGraph(const std::vector<ObjectData>& netObjectData)
+    {
+        for (size_t i = 0; i < netObjectData.size(); ++i)
+        {
+            const auto& objectData = netObjectData[i];
+            if (objectData.objectType != ObjectType::STATIC)
+            {
+                glm::vec3 colliderDimensions(objectData.colliderData.colliderRelativeDimensions.x * objectData.objectScale, objectData.colliderData.colliderRelativeDimensions.y * objectData.objectScale, 1.0f);
+                mDynamicLayer.InsertObject(objectData.objectId, objectData.position, colliderDimensions, i);
+            }
+        }
+    }
+    
+    /// Object types live in the cold side of the table, so unlike the above every object of the
+    /// table is inserted: keep the STATIC objects out of the table.
+    inline void PopulateSceneGraph(const ObjectTable& objectTable)
+    {
+        mDynamicLayer.PopulateSceneGraph(objectTable);
+    }
+    
+    inline void InsertObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions, const size_t objectIndex = NO_OBJECT_INDEX)
+    {
+        mDynamicLayer.InsertObject(objectId, position, dimensions, objectIndex);
+    }
+    
+    /// Only clears the dynamic layer.
+    inline void Clear()
+    {
+        mDynamicLayer.Clear();
+    }
+    
+    inline void ClearStaticLayer()
+    {
+        mStaticLayer.Clear();
+    }
+    
+    // Visitor signature: void(const objectId_t candidateObjectId)
+    template<typename VisitorT>
+    inline void ForEachCollisionCandidate(const ObjectData& objectData, VisitorT&& visitor) const
+    {
+        mDynamicLayer.ForEachCollisionCandidate(objectData, visitor);
+        mStaticLayer.ForEachCollisionCandidate(objectData, visitor);
+    }
+    
+    inline void GetCollisionCandidates(const ObjectData& objectData, std::vector<objectId_t>& outCollisionCandidates) const
+    {
+        outCollisionCandidates.clear();
+        ForEachCollisionCandidate(objectData, [&](const objectId_t candidateObjectId){ outCollisionCandidates.push_back(candidateObjectId); });
+    }
+    
+    inline std::vector<objectId_t> GetCollisionCandidates(const ObjectData& objectData) const
+    {
+        std::vector<objectId_t> collisionCandidates;
+        GetCollisionCandidates(objectData, collisionCandidates);
+        return collisionCandidates;
+    }
+    
+    /// Dynamic/dynamic pairs as with NetworkQuadtree::FindAllCollidingPairs, followed by every
+    /// non STATIC object of netObjectData against the static layer (with the static object as
+    /// rhs). Static/static pairs are never reported.
+    /// Visitor signature: void(const ObjectData& lhs, const ObjectData& rhs)
+    template<typename VisitorT>
+    inline void FindAllCollidingPairs(const std::vector<ObjectData>& netObjectData, VisitorT&& visitor) const
+    {
+        mDynamicLayer.FindAllCollidingPairs(netObjectData, visitor);
+        for (const auto& objectData: netObjectData)
+        {
+            if (objectData.objectType != ObjectType::STATIC)
+            {
+                mStaticLayer.ForEachCollidingObject(objectData, [&](const ObjectData& staticObjectData){ visitor(objectData, staticObjectData); });
+            }
+        }
+    }
+    
+    inline void GetObjectsInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, std::vector<objectId_t>& outObjectIds) const
+    {
+        outObjectIds.clear();
+        ForEachObjectInRect(rectOrigin, rectDimensions, [&](const objectId_t objectId, const glm::vec3&, const glm::vec3&){ outObjectIds.push_back(objectId); });
+    }
+    
+    inline void GetObjectsInRadius(const glm::vec3& center, const float radius, std::vector<objectId_t>& outObjectIds) const
+    {
+        outObjectIds.clear();
+        ForEachObjectInRadius(center, radius, [&](const objectId_t objectId, const glm::vec3&, const glm::vec3&){ outObjectIds.push_back(objectId); });
+    }
+    
+    // Visitor signature: void(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+    template<typename VisitorT>
+    inline void ForEachObjectInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, VisitorT&& visitor) const
+    {
+        mDynamicLayer.ForEachObjectInRect(rectOrigin, rectDimensions, visitor);
+        mStaticLayer.ForEachObjectInRect(rectOrigin, rectDimensions, visitor);
+    }
+    
+    template<typename VisitorT>
+    inline void ForEachObjectInRadius(const glm::vec3& center, const float radius, VisitorT&& visitor) const
+    {
+        mDynamicLayer.ForEachObjectInRadius(center, radius, visitor);
+        mStaticLayer.ForEachObjectInRadius(center, radius, visitor);
+    }
+    
+    inline std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugRenderRectangles() const
+    {
+        auto debugRectangles = mDynamicLayer.GetDebugRenderRectangles();
+        const auto staticDebugRectangles = mStaticLayer.GetDebugRenderRectangles();
+        debugRectangles.insert(debugRectangles.end(), staticDebugRectangles.begin(), staticDebugRectangles.end());
+        return debugRectangles;
+    }
+
+private:
+    StaticObjectLayer mStaticLayer;
+    NetworkQuadtree mDynamicLayer;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // LAYERED_BROADPHASE_H
@@ -0,0 +1,182 @@
+///------------------------------------------------------------------------------------------------
+///  MapGlobalData.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef MAP_GLOBAL_DATA_H
+#define MAP_GLOBAL_DATA_H
+
+///------------------------------------------------------------------------------------------------
+
+#if __has_include(<engine/utils/MathUtils.h>)
+#include <engine/utils/MathUtils.h>
+#else
+#include "../util/MathUtils.h"
+#endif
+
+#include <net_common/JsonReader.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+enum class MapConnectionDirection
+{
+    TOP = 0,
+    BOTTOM,
+    LEFT,
+    RIGHT,
+    COUNT
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* GetMapConnectionDirectionName(const MapConnectionDirection direction)
+{
+    switch (direction)
+    {
+        case MapConnectionDirection::TOP: return "top";
+        case MapConnectionDirection::BOTTOM: return "bottom";
+        case MapConnectionDirection::LEFT: return "left";
+        case MapConnectionDirection::RIGHT: return "right";
+        default: break;
+    }
+    
+    return "";
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline MapConnectionDirection GetOppositeMapConnectionDirection(const MapConnectionDirection direction)
+{
+    switch (direction)
+    {
+        case MapConnectionDirection::TOP: return MapConnectionDirection::BOTTOM;
+        case MapConnectionDirection::BOTTOM: return MapConnectionDirection::TOP;
+        case MapConnectionDirection::LEFT: return MapConnectionDirection::RIGHT;
+        case MapConnectionDirection::RIGHT: return MapConnectionDirection::LEFT;
+        default: break;
+    }
+    
+    return MapConnectionDirection::COUNT;
+}
+
+///------------------------------------------------------------------------------------------------
+/// A map's entry in map_global_data.json. Positions and dimensions are in the global map
+/// space (positive up), where each map's navmap covers the 1x1 area centred on the map.
+struct MapDefinition
+{
+    glm::vec2 mPosition = glm::vec2(0.0f);
+    glm::vec2 mDimensions = glm::vec2(0.0f);
+    std::string mConnectedMaps[static_cast<int>(MapConnectionDirection::COUNT)]; // Empty if there is no connection
+    
+    inline const std::string& GetConnectedMap(const MapConnectionDirection direction) const { return mConnectedMaps[static_cast<int>(direction)]; }
+};
+
+///------------------------------------------------------------------------------------------------
+/// Keyed by map name, i.e. the json file names without the ".json" extension (e.g. "forest_1").
+struct MapGlobalData
+{
+    std::map<std::string, MapDefinition> mMapDefinitions;
+    
+    inline const MapDefinition* FindMapDefinition(const std::string& mapName) const
+    {
+        auto mapIter = mMapDefinitions.find(mapName);
+        return mapIter == mMapDefinitions.end() ? nullptr : &mapIter->second;
+    }
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline std::string GetMapNameFromMapFileName(const std::string& mapFileName)
+{
+    static const std::string MAP_FILE_EXTENSION = ".json";
+    
+    if (mapFileName.size() > MAP_FILE_EXTENSION.size() && mapFileName.compare(mapFileName.size() - MAP_FILE_EXTENSION.size(), MAP_FILE_EXTENSION.size(), MAP_FILE_EXTENSION) == 0)
+    {
+        return mapFileName.substr(0, mapFileName.size() - MAP_FILE_EXTENSION.size());
+    }
+    
+    return mapFileName;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline std::string GetMapNavmapFileName(const std::string& mapName)
+{
+    return mapName + "_navmap.png";
+}
+
+///------------------------------------------------------------------------------------------------
+/// Parses the contents of map_global_data.json. Returns false if the file is malformed.
+inline bool ParseMapGlobalData(const std::string& jsonContents, MapGlobalData& outMapGlobalData)
+{
+    outMapGlobalData.mMapDefinitions.clear();
+    
+    JsonValue root;
+    if (!JsonReader::Parse(jsonContents, root) || root.mType != JsonValueType::OBJECT)
+    {
+        return false;
+    }
+    
+    const auto* mapTransforms = root.FindMember("map_transforms");
+    if (mapTransforms)
+    {
+        for (const auto& mapTransform: mapTransforms->mObject)
+        {
+            auto& mapDefinition = outMapGlobalData.mMapDefinitions[GetMapNameFromMapFileName(mapTransform.first)];
+            mapDefinition.mPosition.x = static_cast<float>(mapTransform.second.GetNumberMember("x", 0.0));
+            mapDefinition.mPosition.y = static_cast<float>(mapTransform.second.GetNumberMember("y", 0.0));
+            mapDefinition.mDimensions.x = static_cast<float>(mapTransform.second.GetNumberMember("width", 0.0));
+            mapDefinition.mDimensions.y = static_cast<float>(mapTransform.second.GetNumberMember("height", 0.0));
+        }
+    }
+    
+    const auto* mapConnections = root.FindMember("map_connections");
+    if (mapConnections)
+    {
+        for (const auto& mapConnection: mapConnections->mObject)
+        {
+            auto& mapDefinition = outMapGlobalData.mMapDefinitions[GetMapNameFromMapFileName(mapConnection.first)];
+            for (int i = 0; i < static_cast<int>(MapConnectionDirection::COUNT); ++i)
+            {
+                const auto connectedMapFileName = mapConnection.second.GetStringMember(GetMapConnectionDirectionName(static_cast<MapConnectionDirection>(i)), "None");
+                mapDefinition.mConnectedMaps[i] = connectedMapFileName == "None" ? std::string() : GetMapNameFromMapFileName(connectedMapFileName);
+            }
+        }
+    }
+    
+    return mapTransforms != nullptr && mapConnections != nullptr;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline bool LoadMapGlobalData(const std::string& filePath, MapGlobalData& outMapGlobalData)
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    
+    std::stringstream fileContents;
+    fileContents << file.rdbuf();
+    return ParseMapGlobalData(fileContents.str(), outMapGlobalData);
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // MAP_GLOBAL_DATA_H
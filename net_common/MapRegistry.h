@@ -0,0 +1,122 @@
+///------------------------------------------------------------------------------------------------
+///  MapRegistry.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef MAP_REGISTRY_H
+#define MAP_REGISTRY_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/MapGlobalData.h>
+#include <net_common/NetworkCommon.h>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+using mapId_t = uint16_t;
+inline constexpr mapId_t INVALID_MAP_ID = static_cast<mapId_t>(-1);
+
+///------------------------------------------------------------------------------------------------
+/// Interns the map names of map_global_data.json into small integer ids, assigned in map name
+/// order so that they are the same on every run. Name lookups (e.g. of ObjectData::currentMap)
+/// are only needed when an object enters the world; from then on everything can be keyed by
+/// mapId_t without any string work.
+class MapRegistry final
+{
+public:
+    MapRegistry(const MapGlobalData& mapGlobalData)
+    {
+        // MapGlobalData's std::map already iterates in name order
+        mMaps.reserve(mapGlobalData.mMapDefinitions.size());
+        for (const auto& mapDefinitionEntry: mapGlobalData.mMapDefinitions)
+        {
+            RegisteredMap registeredMap;
+            registeredMap.mName = mapDefinitionEntry.first;
+            registeredMap.mDefinition = mapDefinitionEntry.second;
+            mMaps.push_back(std::move(registeredMap));
+        }
+        
+        for (auto& registeredMap: mMaps)
+        {
+            for (int i = 0; i < static_cast<int>(MapConnectionDirection::COUNT); ++i)
+            {
+                const auto& connectedMapName = registeredMap.mDefinition.mConnectedMaps[i];
+                registeredMap.mConnectedMapIds[i] = connectedMapName.empty() ? INVALID_MAP_ID : GetMapId(connectedMapName);
+            }
+        }
+    }
+    
+    inline size_t GetMapCount() const { return mMaps.size(); }
+    
+    /// Returns INVALID_MAP_ID for unknown maps.
+    inline mapId_t GetMapId(const std::string_view mapName) const
+    {
+        auto mapIter = std::lower_bound(mMaps.begin(), mMaps.end(), mapName, [](const RegisteredMap& registeredMap, const std::string_view name){ return std::string_view(registeredMap.mName) < name; });
+        return mapIter != mMaps.end() && mapIter->mName == mapName ? static_cast<mapId_t>(mapIter - mMaps.begin()) : INVALID_MAP_ID;
+    }
+    
+    inline mapId_t GetMapId(const ObjectData& objectData) const
+    {
+        return GetMapId(std::string_view(objectData.currentMap, strnlen(objectData.currentMap, sizeof(objectData.currentMap))));
+    }
+    
+    inline const std::string& GetMapName(const mapId_t mapId) const { return mMaps[mapId].mName; }
+    inline const MapDefinition& GetMapDefinition(const mapId_t mapId) const { return mMaps[mapId].mDefinition; }
+    
+    /// Returns INVALID_MAP_ID if there is no connection in that direction.
+    inline mapId_t GetConnectedMapId(const mapId_t mapId, const MapConnectionDirection direction) const
+    {
+        return mMaps[mapId].mConnectedMapIds[static_cast<int>(direction)];
+    }
+    
+    /// Same as SetCurrentMap, without going through a std::string. Takes anything with ObjectData's
+    /// currentMap member (e.g. an ObjectColdData of an ObjectTable).
+    template<typename ObjectDataT>
+    inline void WriteCurrentMap(const mapId_t mapId, ObjectDataT& objectData) const
+    {
+        const auto& mapName = mMaps[mapId].mName;
+        const auto nameLength = math::Min(mapName.size(), sizeof(objectData.currentMap) - 1);
+        std::memcpy(objectData.currentMap, mapName.data(), nameLength);
+        std::memset(objectData.currentMap + nameLength, 0, sizeof(objectData.currentMap) - nameLength);
+    }
+    
+    /// The playable area of the map in game space (i.e. MAP_GAME_SCALE units per unit of the
+    /// global map space), which positions of objects on the map are in.
+    inline void GetMapGameBounds(const mapId_t mapId, glm::vec2& outBoundsMin, glm::vec2& outBoundsMax) const
+    {
+        const auto& mapDefinition = mMaps[mapId].mDefinition;
+        const auto center = mapDefinition.mPosition * MAP_GAME_SCALE;
+        const auto halfExtents = mapDefinition.mDimensions * (MAP_GAME_SCALE * 0.5f);
+        outBoundsMin = center - halfExtents;
+        outBoundsMax = center + halfExtents;
+    }
+
+private:
+    struct RegisteredMap
+    {
+        std::string mName;
+        MapDefinition mDefinition;
+        mapId_t mConnectedMapIds[static_cast<int>(MapConnectionDirection::COUNT)];
+    };
+    
+    std::vector<RegisteredMap> mMaps; // Indexed by mapId_t, in name order
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // MAP_REGISTRY_H
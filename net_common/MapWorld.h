@@ -0,0 +1,228 @@
+///------------------------------------------------------------------------------------------------
+///  MapWorld.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef MAP_WORLD_H
+#define MAP_WORLD_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/JobPool.h>
+#include <net_common/MapRegistry.h>
+#include <net_common/Navmap.h>
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/ObjectTable.h>
+#include <memory>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+struct MapHandoff
+{
+    objectId_t mObjectId;
+    mapId_t mFromMapId;
+    mapId_t mToMapId;
+};
+
+///------------------------------------------------------------------------------------------------
+/// The objects of a single map, along with the map's own broadphase and navmap. A map world only
+/// ever touches its own state, so different map worlds can be ticked on different threads.
+/// Objects leaving the map are queued for handoff (see MapWorldSet::ApplyHandoffs) rather than
+/// moved right away.
+template<typename BroadphaseT = NetworkQuadtree>
+class MapWorld final
+{
+public:
+    MapWorld(const MapRegistry& mapRegistry, const mapId_t mapId, const Navmap* navmap = nullptr)
+    : mMapRegistry(mapRegistry)
+    , mMapId(mapId)
+    , mNavmap(navmap)
+    {
+        mapRegistry.GetMapGameBounds(mapId, mBoundsMin, mBoundsMax);
+        
+        // The broadphase covers the map's whole navmap area, as objects can be slightly out of bounds before their handoff
+        const auto& mapDefinition = mapRegistry.GetMapDefinition(mapId);
+        mBroadphase = std::make_unique<BroadphaseT>(glm::vec3(mapDefinition.mPosition * MAP_GAME_SCALE, 0.0f), glm::vec3(MAP_GAME_SCALE, MAP_GAME_SCALE, 1.0f));
+    }
+    
+    inline mapId_t GetMapId() const { return mMapId; }
+    inline const std::string& GetMapName() const { return mMapRegistry.GetMapName(mMapId); }
+    inline const Navmap* GetNavmap() const { return mNavmap; }
+    inline void SetNavmap(const Navmap* navmap) { mNavmap = navmap; }
+    inline const glm::vec2& GetBoundsMin() const { return mBoundsMin; }
+    inline const glm::vec2& GetBoundsMax() const { return mBoundsMax; }
+    
+    /// The object's currentMap is set to this map. Returns a null handle if the object id is
+    /// already in the map.
+    inline ObjectHandle AddObject(const ObjectData& objectData)
+    {
+        const auto objectHandle = mObjectTable.AddObject(objectData);
+        if (!objectHandle.IsNull())
+        {
+            mMapRegistry.WriteCurrentMap(mMapId, mObjectTable.GetColdData(mObjectTable.GetObjectIndex(objectHandle)));
+        }
+        
+        return objectHandle;
+    }
+    
+    /// Swap-removes the object, optionally copying it out first.
+    inline bool RemoveObject(const objectId_t objectId, ObjectData* outObjectData = nullptr)
+    {
+        return mObjectTable.RemoveObject(objectId, outObjectData);
+    }
+    
+    /// Returns a null handle for objects not in the map.
+    inline ObjectHandle FindObject(const objectId_t objectId) const
+    {
+        return mObjectTable.FindObject(objectId);
+    }
+    
+    inline ObjectTable& GetObjectTable() { return mObjectTable; }
+    inline const ObjectTable& GetObjectTable() const { return mObjectTable; }
+    
+    /// Repopulates the broadphase from the current objects, e.g. once per tick after movement.
+    /// The broadphase's object indices refer to GetObjectTable().
+    inline void RebuildBroadphase()
+    {
+        mBroadphase->Clear();
+        mBroadphase->PopulateSceneGraph(mObjectTable);
+    }
+    
+    inline const BroadphaseT& GetBroadphase() const { return *mBroadphase; }
+    
+    /// The map edge a position is past, or COUNT if it's inside the map.
+    inline MapConnectionDirection GetExitDirection(const glm::vec3& position) const
+    {
+        if (position.x < mBoundsMin.x) return MapConnectionDirection::LEFT;
+        if (position.x > mBoundsMax.x) return MapConnectionDirection::RIGHT;
+        if (position.y > mBoundsMax.y) return MapConnectionDirection::TOP;
+        if (position.y < mBoundsMin.y) return MapConnectionDirection::BOTTOM;
+        return MapConnectionDirection::COUNT;
+    }
+    
+    /// Queues the object for a handoff to the map connected in the given direction. Returns
+    /// false (and queues nothing) if there is no connection that way.
+    inline bool QueueHandoff(const objectId_t objectId, const MapConnectionDirection direction)
+    {
+        const auto toMapId = direction == MapConnectionDirection::COUNT ? INVALID_MAP_ID : mMapRegistry.GetConnectedMapId(mMapId, direction);
+        if (toMapId == INVALID_MAP_ID)
+        {
+            return false;
+        }
+        
+        mPendingHandoffs.push_back(MapHandoff{ objectId, mMapId, toMapId });
+        return true;
+    }
+    
+    /// Queues a handoff for every object past a connected edge of the map. Objects past edges
+    /// without a connection are left for the game logic to push back in.
+    inline void QueueExitedObjectHandoffs()
+    {
+        const auto& objectIds = mObjectTable.GetObjectIds();
+        const auto& positions = mObjectTable.GetPositions();
+        for (size_t i = 0; i < mObjectTable.GetObjectCount(); ++i)
+        {
+            const auto exitDirection = GetExitDirection(positions[i]);
+            if (exitDirection != MapConnectionDirection::COUNT)
+            {
+                QueueHandoff(objectIds[i], exitDirection);
+            }
+        }
+    }
+    
+    inline std::vector<MapHandoff>& GetPendingHandoffs() { return mPendingHandoffs; }
+
+private:
+    const MapRegistry& mMapRegistry;
+    const mapId_t mMapId;
+    const Navmap* mNavmap;
+    glm::vec2 mBoundsMin;
+    glm::vec2 mBoundsMax;
+    std::unique_ptr<BroadphaseT> mBroadphase;
+    ObjectTable mObjectTable;
+    std::vector<MapHandoff> mPendingHandoffs;
+};
+
+///------------------------------------------------------------------------------------------------
+/// One MapWorld per map of the registry, indexed by mapId_t. Maps are the unit of parallelism:
+///
+///     mapWorldSet.TickMapWorlds(jobPool, [&](MapWorld<>& mapWorld){ ...; mapWorld.QueueExitedObjectHandoffs(); });
+///     mapWorldSet.ApplyHandoffs(handoffs);
+///
+/// Handoffs are applied on the calling thread in (source map id, queueing) order, so the result
+/// doesn't depend on how the maps were scheduled.
+template<typename BroadphaseT = NetworkQuadtree>
+class MapWorldSet final
+{
+public:
+    MapWorldSet(const MapRegistry& mapRegistry)
+    : mMapRegistry(mapRegistry)
+    {
+        mMapWorlds.reserve(mapRegistry.GetMapCount());
+        for (size_t mapId = 0; mapId < mapRegistry.GetMapCount(); ++mapId)
+        {
+            mMapWorlds.push_back(std::make_unique<MapWorld<BroadphaseT>>(mapRegistry, static_cast<mapId_t>(mapId)));
+        }
+    }
+    
+    inline size_t GetMapWorldCount() const { return mMapWorlds.size(); }
+    inline MapWorld<BroadphaseT>& GetMapWorld(const mapId_t mapId) { return *mMapWorlds[mapId]; }
+    inline const MapWorld<BroadphaseT>& GetMapWorld(const mapId_t mapId) const { return *mMapWorlds[mapId]; }
+    
+    /// Adds the object to the map named by its currentMap. Returns a null handle for unknown maps
+    /// and duplicate object ids.
+    inline ObjectHandle AddObject(const ObjectData& objectData)
+    {
+        const auto mapId = mMapRegistry.GetMapId(objectData);
+        return mapId == INVALID_MAP_ID ? ObjectHandle() : mMapWorlds[mapId]->AddObject(objectData);
+    }
+    
+    /// Runs tickFunction(MapWorld&) for every map, in parallel across the job pool.
+    template<typename TickFunctionT>
+    inline void TickMapWorlds(JobPool& jobPool, TickFunctionT&& tickFunction)
+    {
+        jobPool.ParallelFor(mMapWorlds.size(), [&](const size_t, const size_t mapId){ tickFunction(*mMapWorlds[mapId]); });
+    }
+    
+    /// Moves the objects queued for handoff to their new maps, and clears and fills
+    /// outAppliedHandoffs with the ones that went through (e.g. to notify clients).
+    inline void ApplyHandoffs(std::vector<MapHandoff>& outAppliedHandoffs)
+    {
+        outAppliedHandoffs.clear();
+        for (auto& mapWorld: mMapWorlds)
+        {
+            for (const auto& handoff: mapWorld->GetPendingHandoffs())
+            {
+                auto& toMapWorld = *mMapWorlds[handoff.mToMapId];
+                if (toMapWorld.FindObject(handoff.mObjectId).IsNull() && mapWorld->RemoveObject(handoff.mObjectId, &mScratchObjectData))
+                {
+                    toMapWorld.AddObject(mScratchObjectData);
+                    outAppliedHandoffs.push_back(handoff);
+                }
+            }
+            
+            mapWorld->GetPendingHandoffs().clear();
+        }
+    }
+
+private:
+    const MapRegistry& mMapRegistry;
+    std::vector<std::unique_ptr<MapWorld<BroadphaseT>>> mMapWorlds;
+    ObjectData mScratchObjectData;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // MAP_WORLD_H
@@ -0,0 +1,194 @@
+///------------------------------------------------------------------------------------------------
+///  MessageDispatch.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef MESSAGE_DISPATCH_H
+#define MESSAGE_DISPATCH_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/MessageFrame.h>
+#include <type_traits>
+#include <utility>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+namespace message_dispatch
+{
+
+///------------------------------------------------------------------------------------------------
+
+template<typename HandlerT, typename MessageT, typename = void>
+struct HasMessageHandler : std::false_type {};
+
+template<typename HandlerT, typename MessageT>
+struct HasMessageHandler<HandlerT, MessageT, std::void_t<decltype(std::declval<HandlerT&>().OnMessage(std::declval<const MessageT&>()))>> : std::true_type {};
+
+///------------------------------------------------------------------------------------------------
+
+template<typename HandlerT>
+using MessageDispatchFunction = bool(*)(const unsigned char*, const size_t, HandlerT&);
+
+///------------------------------------------------------------------------------------------------
+
+template<typename HandlerT, typename MessageT>
+inline bool DispatchTypedMessage(const unsigned char* messageData, const size_t messageSize, HandlerT& handler)
+{
+    if constexpr (std::is_same_v<MessageT, ObjectStateDeltaUpdateMessage>)
+    {
+        // Only the live part of the delta payload is on the wire, so it always needs a copy
+        ObjectStateDeltaUpdateMessage message;
+        if (!ReadObjectStateDeltaUpdateMessage(messageData, messageSize, message))
+        {
+            return false;
+        }
+        
+        if constexpr (HasMessageHandler<HandlerT, MessageT>::value)
+        {
+            handler.OnMessage(message);
+        }
+        return true;
+    }
+    else if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        // Packed on the wire (see WriteMessage), so it always needs to be unpacked into a copy
+        MessageT message;
+        if (!ReadMessage(messageData, messageSize, message))
+        {
+            return false;
+        }
+        
+        if constexpr (HasMessageHandler<HandlerT, MessageT>::value)
+        {
+            handler.OnMessage(message);
+        }
+        return true;
+    }
+    else if constexpr (std::is_same_v<MessageT, MessageFrameMessage>)
+    {
+        // Frames are unpacked by DispatchPacket, and never nested
+        return false;
+    }
+    else
+    {
+        if (messageSize != sizeof(MessageT))
+        {
+            return false;
+        }
+        
+        if constexpr (HasMessageHandler<HandlerT, MessageT>::value)
+        {
+            // Messages inside frames are packed back to back, so they may be misaligned
+            if (reinterpret_cast<uintptr_t>(messageData) % alignof(MessageT) == 0)
+            {
+                handler.OnMessage(*reinterpret_cast<const MessageT*>(messageData));
+            }
+            else
+            {
+                MessageT message;
+                std::memcpy(&message, messageData, sizeof(MessageT));
+                handler.OnMessage(message);
+            }
+        }
+        return true;
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+#define BEGIN_MESSAGE(messageName) &DispatchTypedMessage<HandlerT, messageName>,
+#define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity)
+#define STRING_FIELD(name, capacity)
+#define END_MESSAGE()
+
+template<typename HandlerT>
+inline constexpr MessageDispatchFunction<HandlerT> MESSAGE_DISPATCH_TABLE[] =
+{
+#include <net_common/NetworkMessages.inc>
+};
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+/// Typed receive path generated from NetworkMessages.inc. The handler is any object with
+/// OnMessage overloads for the messages it cares about:
+///
+///     struct ServerMessageHandler
+///     {
+///         void OnMessage(const BeginAttackRequestMessage& message);
+///         void OnMessage(const CancelAttackMessage& message);
+///     };
+///
+///     DispatchPacket(packet->data, packet->dataLength, handler);
+///
+/// Message types the handler has no overload for are size checked (variable length messages are
+/// fully validated) and then skipped. Dispatching is a bounds checked lookup into a constexpr
+/// table of function pointers per handler type, so there are no virtual calls or allocations
+/// involved. Version checks are not part of it (see GetMessageVersionValidity and the handshake
+/// in CompactMessages.h).
+///
+/// Dispatches a single message, in the full header format. Returns false for unknown message
+/// types and for messages whose size doesn't match their struct (or their packed fields).
+template<typename HandlerT>
+inline bool DispatchMessage(const unsigned char* messageData, const size_t messageSize, HandlerT& handler)
+{
+    static_assert(sizeof(message_dispatch::MESSAGE_DISPATCH_TABLE<HandlerT>)/sizeof(message_dispatch::MESSAGE_DISPATCH_TABLE<HandlerT>[0]) == static_cast<size_t>(MessageType::UNUSED));
+    
+    if (messageSize == 0 || messageData[0] >= static_cast<uint8_t>(MessageType::UNUSED))
+    {
+        return false;
+    }
+    
+    NET_STATS_MESSAGE_RECEIVED(messageData, messageSize);
+    return message_dispatch::MESSAGE_DISPATCH_TABLE<HandlerT>[messageData[0]](messageData, messageSize, handler);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Dispatches all messages of a received packet, unpacking message frames. Stops at the first
+/// invalid message and returns false.
+template<typename HandlerT>
+inline bool DispatchPacket(const unsigned char* packetData, const size_t packetSize, HandlerT& handler)
+{
+    MessageFrameReader frameReader(packetData, packetSize);
+    if (frameReader.IsFrame())
+    {
+        NET_STATS_MESSAGE_RECEIVED(packetData, packetSize);
+    }
+    
+    const unsigned char* messageData = nullptr;
+    size_t messageSize = 0;
+    while (frameReader.GetNextMessage(messageData, messageSize))
+    {
+        if (!DispatchMessage(messageData, messageSize, handler))
+        {
+            return false;
+        }
+    }
+    
+    return frameReader.IsValid();
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // MESSAGE_DISPATCH_H
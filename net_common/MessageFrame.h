@@ -0,0 +1,336 @@
+///------------------------------------------------------------------------------------------------
+///  MessageFrame.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef MESSAGE_FRAME_H
+#define MESSAGE_FRAME_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkMessages.h>
+#include <net_common/PacketBufferPool.h>
+#include <limits>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+// Keeps unreliable frames under a typical path MTU so that ENet doesn't need to fragment them.
+inline constexpr size_t DEFAULT_MAX_MESSAGE_FRAME_SIZE = 1200;
+
+using messageFrameEntrySize_t = uint16_t;
+
+///------------------------------------------------------------------------------------------------
+/// Packs many messages into a single packet payload:
+///
+///     [MessageFrameMessage][size_0][message_0][size_1][message_1]...
+///
+/// The sizes are 16 bit and the messages are stored back to back, so a contained
+/// message is not necessarily aligned; copy it out before reinterpreting it.
+class MessageFrameBuilder
+{
+public:
+    MessageFrameBuilder(const size_t maxFrameSize = DEFAULT_MAX_MESSAGE_FRAME_SIZE)
+    : mMaxFrameSize(maxFrameSize)
+    , mMessageCount(0)
+    {
+        mFrameData.reserve(mMaxFrameSize);
+        Reset();
+    }
+    
+    /// Variable length messages are packed straight into the frame (see WriteMessage).
+    template<typename MessageT>
+    inline bool AppendMessage(const MessageT& message)
+    {
+        if constexpr (MessageT::IS_VARIABLE_LENGTH)
+        {
+            const auto messageSize = GetMessageWireSize(message);
+            if (!CanFitMessage(messageSize))
+            {
+                return false;
+            }
+            
+            const auto entryOffset = mFrameData.size();
+            const auto entrySize = static_cast<messageFrameEntrySize_t>(messageSize);
+            mFrameData.resize(entryOffset + sizeof(entrySize) + messageSize);
+            
+            auto* messageBytes = mFrameData.data() + entryOffset + sizeof(entrySize);
+            std::memcpy(mFrameData.data() + entryOffset, &entrySize, sizeof(entrySize));
+            if (WriteMessage(message, messageBytes, messageSize) == 0)
+            {
+                mFrameData.resize(entryOffset);
+                return false;
+            }
+            
+            mMessageCount++;
+            NET_STATS_MESSAGE_SENT(messageBytes, messageSize);
+            
+            return true;
+        }
+        else
+        {
+            return AppendMessage(&message, sizeof(MessageT));
+        }
+    }
+    
+    /// Returns false if the message would not fit in the remaining frame space.
+    inline bool AppendMessage(const void* message, const size_t messageSize)
+    {
+        if (!CanFitMessage(messageSize))
+        {
+            return false;
+        }
+        
+        const auto entrySize = static_cast<messageFrameEntrySize_t>(messageSize);
+        const auto* entrySizeBytes = reinterpret_cast<const unsigned char*>(&entrySize);
+        const auto* messageBytes = static_cast<const unsigned char*>(message);
+        
+        mFrameData.insert(mFrameData.end(), entrySizeBytes, entrySizeBytes + sizeof(entrySize));
+        mFrameData.insert(mFrameData.end(), messageBytes, messageBytes + messageSize);
+        mMessageCount++;
+        
+        // The frame itself is counted as a MessageFrameMessage when sent
+        NET_STATS_MESSAGE_SENT(message, messageSize);
+        
+        return true;
+    }
+    
+    /// Also false once the frame holds as many messages as its 16 bit message count can hold.
+    inline bool CanFitMessage(const size_t messageSize) const
+    {
+        return mMessageCount < std::numeric_limits<uint16_t>::max() && messageSize <= GetMaxMessageSize() && mFrameData.size() + sizeof(messageFrameEntrySize_t) + messageSize <= mMaxFrameSize;
+    }
+    
+    /// Largest message that fits in an otherwise empty frame, which the 16 bit entry sizes
+    /// cap regardless of the frame size.
+    inline size_t GetMaxMessageSize() const
+    {
+        const auto frameOverhead = sizeof(MessageFrameMessage) + sizeof(messageFrameEntrySize_t);
+        const auto maxEntrySize = static_cast<size_t>(std::numeric_limits<messageFrameEntrySize_t>::max());
+        return mMaxFrameSize > frameOverhead ? math::Min(mMaxFrameSize - frameOverhead, maxEntrySize) : 0;
+    }
+    
+    inline bool IsEmpty() const { return mMessageCount == 0; }
+    inline uint16_t GetMessageCount() const { return mMessageCount; }
+    
+    /// Finalizes the frame header. The returned bytes stay valid until the next Reset/Append.
+    inline const std::vector<unsigned char>& GetFrameData()
+    {
+        MessageFrameMessage frameMessage;
+        frameMessage.messageCount = mMessageCount;
+        std::memcpy(mFrameData.data(), &frameMessage, sizeof(frameMessage));
+        return mFrameData;
+    }
+    
+    /// Clears the frame without releasing its storage.
+    inline void Reset()
+    {
+        mFrameData.resize(sizeof(MessageFrameMessage));
+        mMessageCount = 0;
+    }
+
+private:
+    const size_t mMaxFrameSize;
+    std::vector<unsigned char> mFrameData;
+    uint16_t mMessageCount;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Per peer, per channel batching of outgoing messages. Queue messages during the tick
+/// and Flush() once at the end of it; a frame that fills up mid-tick is sent right away.
+/// Messages too large for a frame (e.g. the debug quadtree response) are sent on their own,
+/// as are messages on channels other than channels::UNRELIABLE and channels::RELIABLE.
+/// With a (shared) packet buffer pool, the sent frames reuse pooled payload buffers.
+class PeerMessageFrameBatcher
+{
+public:
+    PeerMessageFrameBatcher(ENetPeer* peer, const size_t maxFrameSize = DEFAULT_MAX_MESSAGE_FRAME_SIZE, PacketBufferPool* packetBufferPool = nullptr)
+    : mPeer(peer)
+    , mPacketBufferPool(packetBufferPool)
+    , mFrameBuilders{ MessageFrameBuilder(maxFrameSize), MessageFrameBuilder(maxFrameSize) }
+    {
+    }
+    
+    template<typename MessageT>
+    inline void QueueMessage(const MessageT& message, const enet_uint32 channel)
+    {
+        if constexpr (MessageT::IS_VARIABLE_LENGTH)
+        {
+            mSerializedMessage.resize(GetMessageWireSize(message));
+            if (WriteMessage(message, mSerializedMessage.data(), mSerializedMessage.size()) != 0)
+            {
+                QueueMessage(mSerializedMessage.data(), mSerializedMessage.size(), channel);
+            }
+        }
+        else
+        {
+            QueueMessage(&message, sizeof(MessageT), channel);
+        }
+    }
+    
+    inline void QueueMessage(const void* message, const size_t messageSize, const enet_uint32 channel)
+    {
+        if (channel >= BATCHED_CHANNEL_COUNT)
+        {
+            SendPacketData(message, messageSize, channel);
+            return;
+        }
+        
+        auto& frameBuilder = mFrameBuilders[channel];
+        if (messageSize > frameBuilder.GetMaxMessageSize())
+        {
+            // Preserve the queueing order on this channel
+            FlushChannel(channel);
+            SendPacketData(message, messageSize, channel);
+            return;
+        }
+        
+        if (!frameBuilder.CanFitMessage(messageSize))
+        {
+            FlushChannel(channel);
+        }
+        
+        frameBuilder.AppendMessage(message, messageSize);
+    }
+    
+    inline void Flush()
+    {
+        FlushChannel(channels::UNRELIABLE);
+        FlushChannel(channels::RELIABLE);
+    }
+    
+    inline ENetPeer* GetPeer() const { return mPeer; }
+
+private:
+    inline void FlushChannel(const enet_uint32 channel)
+    {
+        auto& frameBuilder = mFrameBuilders[channel];
+        if (frameBuilder.IsEmpty())
+        {
+            return;
+        }
+        
+        const auto& frameData = frameBuilder.GetFrameData();
+        SendPacketData(frameData.data(), frameData.size(), channel);
+        frameBuilder.Reset();
+    }
+    
+    inline void SendPacketData(const void* packetData, const size_t packetSize, const enet_uint32 channel)
+    {
+        if (mPacketBufferPool != nullptr)
+        {
+            SendMessage(mPeer, packetData, packetSize, channel, *mPacketBufferPool);
+        }
+        else
+        {
+            SendMessage(mPeer, packetData, packetSize, channel);
+        }
+    }
+
+private:
+    static constexpr enet_uint32 BATCHED_CHANNEL_COUNT = 2;
+    
+    ENetPeer* mPeer;
+    PacketBufferPool* mPacketBufferPool;
+    MessageFrameBuilder mFrameBuilders[BATCHED_CHANNEL_COUNT];
+    std::vector<unsigned char> mSerializedMessage;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Iterates the messages of a received packet. Packets that are not frames are yielded
+/// as a single message, so receivers can use the same loop for both:
+///
+///     MessageFrameReader reader(packet->data, packet->dataLength);
+///     while (reader.GetNextMessage(messageData, messageSize)) { ... }
+///
+/// Iteration stops at the first malformed entry, after which IsValid() returns false.
+class MessageFrameReader
+{
+public:
+    MessageFrameReader(const unsigned char* packetData, const size_t packetSize)
+    : mPacketData(packetData)
+    , mPacketSize(packetSize)
+    , mReadOffset(0)
+    , mRemainingMessages(0)
+    , mIsFrame(false)
+    , mIsValid(true)
+    {
+        if (mPacketSize >= sizeof(MessageFrameMessage) && static_cast<MessageType>(mPacketData[0]) == MessageType::MessageFrameMessage)
+        {
+            MessageFrameMessage frameMessage;
+            std::memcpy(&frameMessage, mPacketData, sizeof(frameMessage));
+            
+            mIsFrame = true;
+            mRemainingMessages = frameMessage.messageCount;
+            mReadOffset = sizeof(MessageFrameMessage);
+        }
+        else
+        {
+            mRemainingMessages = mPacketSize > 0 ? 1 : 0;
+        }
+    }
+    
+    inline bool GetNextMessage(const unsigned char*& outMessageData, size_t& outMessageSize)
+    {
+        if (!mIsValid || mRemainingMessages == 0)
+        {
+            return false;
+        }
+        
+        mRemainingMessages--;
+        
+        if (!mIsFrame)
+        {
+            outMessageData = mPacketData;
+            outMessageSize = mPacketSize;
+            return true;
+        }
+        
+        messageFrameEntrySize_t entrySize = 0;
+        if (mReadOffset + sizeof(entrySize) > mPacketSize)
+        {
+            mIsValid = false;
+            return false;
+        }
+        
+        std::memcpy(&entrySize, mPacketData + mReadOffset, sizeof(entrySize));
+        mReadOffset += sizeof(entrySize);
+        
+        if (entrySize == 0 || mReadOffset + entrySize > mPacketSize)
+        {
+            mIsValid = false;
+            return false;
+        }
+        
+        outMessageData = mPacketData + mReadOffset;
+        outMessageSize = entrySize;
+        mReadOffset += entrySize;
+        return true;
+    }
+    
+    inline bool IsFrame() const { return mIsFrame; }
+    inline bool IsValid() const { return mIsValid; }
+
+private:
+    const unsigned char* mPacketData;
+    const size_t mPacketSize;
+    size_t mReadOffset;
+    uint16_t mRemainingMessages;
+    bool mIsFrame;
+    bool mIsValid;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // MESSAGE_FRAME_H
@@ -0,0 +1,331 @@
+///------------------------------------------------------------------------------------------------
+///  NavmapFlowField.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef NavmapFlowField_h
+#define NavmapFlowField_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NavmapPathfinder.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline constexpr int8_t NO_FLOW_DIRECTION = -1;
+
+///------------------------------------------------------------------------------------------------
+/// Distance & direction field towards a single goal tile, built with one Dijkstra run from
+/// the goal using the costs and movement rules (8 directions, no corner cutting) of a
+/// NavmapPathfinder. Any number of agents can then sample their next step in O(1).
+///
+/// Builds can be time sliced: BeginBuild once, then ContinueBuild with a node budget every
+/// tick until it returns true. Build does both in one go.
+class NavmapFlowField final
+{
+public:
+    NavmapFlowField()
+    : mNavmapSize(0)
+    , mGoalCoord(-1, -1)
+    , mIsBuilt(false)
+    {
+    }
+    
+    inline void Build(const NavmapPathfinder& pathfinder, const glm::ivec2& goalCoord)
+    {
+        BeginBuild(pathfinder, goalCoord);
+        
+        int unboundedBudget = std::numeric_limits<int>::max();
+        ContinueBuild(pathfinder, unboundedBudget);
+    }
+    
+    inline void BeginBuild(const NavmapPathfinder& pathfinder, const glm::ivec2& goalCoord)
+    {
+        NET_STATS_ADD(NetStatCounter::NAVMAP_FLOW_FIELD_BUILDS, 1);
+        
+        const auto tileCount = static_cast<size_t>(pathfinder.GetSize()) * pathfinder.GetSize();
+        
+        mNavmapSize = pathfinder.GetSize();
+        mGoalCoord = goalCoord;
+        mIsBuilt = false;
+        mCostsToGoal.assign(tileCount, std::numeric_limits<float>::infinity());
+        mFlowDirections.assign(tileCount, NO_FLOW_DIRECTION);
+        mOpenHeap.clear();
+        
+        if (pathfinder.IsPassable(goalCoord))
+        {
+            const auto goalIndex = goalCoord.y * mNavmapSize + goalCoord.x;
+            mCostsToGoal[goalIndex] = 0.0f;
+            PushOpenEntry(goalIndex, 0.0f);
+        }
+    }
+    
+    /// Settles up to remainingNodeBudget tiles (decrementing it) and returns true once the field is complete.
+    inline bool ContinueBuild(const NavmapPathfinder& pathfinder, int& remainingNodeBudget)
+    {
+        NET_STATS_SCOPED_TIMER(NetStatHistogram::NAVMAP_FLOW_FIELD_SLICE_NANOS);
+        
+        while (!mOpenHeap.empty() && remainingNodeBudget > 0)
+        {
+            std::pop_heap(mOpenHeap.begin(), mOpenHeap.end(), &NavmapFlowField::IsLowerPriorityOpenEntry);
+            const auto openEntry = mOpenHeap.back();
+            mOpenHeap.pop_back();
+            
+            if (openEntry.mCostToGoal > mCostsToGoal[openEntry.mNodeIndex])
+            {
+                continue;
+            }
+            
+            remainingNodeBudget--;
+            
+            // Relax the tiles that can step onto this one: moving in direction d from
+            // (x - dx, y - dy) lands here and costs the step length times this tile's cost.
+            const glm::ivec2 nodeCoord(openEntry.mNodeIndex % mNavmapSize, openEntry.mNodeIndex / mNavmapSize);
+            const auto nodeTileCost = pathfinder.GetTileCost(nodeCoord);
+            for (int direction = 0; direction < 8; ++direction)
+            {
+                const auto offset = GetNavmapCoordOffset(static_cast<FacingDirection>(direction));
+                const auto sourceCoord = nodeCoord - offset;
+                if (!pathfinder.IsPassable(sourceCoord))
+                {
+                    continue;
+                }
+                
+                if (offset.x != 0 && offset.y != 0 && (!pathfinder.IsPassable(glm::ivec2(sourceCoord.x + offset.x, sourceCoord.y)) || !pathfinder.IsPassable(glm::ivec2(sourceCoord.x, sourceCoord.y + offset.y))))
+                {
+                    continue;
+                }
+                
+                const auto sourceIndex = sourceCoord.y * mNavmapSize + sourceCoord.x;
+                const auto stepLength = (offset.x != 0 && offset.y != 0) ? DIAGONAL_STEP_LENGTH : 1.0f;
+                const auto sourceCost = openEntry.mCostToGoal + stepLength * nodeTileCost;
+                if (sourceCost < mCostsToGoal[sourceIndex])
+                {
+                    mCostsToGoal[sourceIndex] = sourceCost;
+                    mFlowDirections[sourceIndex] = static_cast<int8_t>(direction);
+                    PushOpenEntry(sourceIndex, sourceCost);
+                }
+            }
+        }
+        
+        mIsBuilt = mOpenHeap.empty();
+        return mIsBuilt;
+    }
+    
+    /// False at the goal itself, on unreachable tiles and outside the navmap.
+    inline bool GetFlowDirection(const glm::ivec2& navmapCoord, FacingDirection& outFacingDirection) const
+    {
+        if (!IsNavmapCoordInBounds(navmapCoord))
+        {
+            return false;
+        }
+        
+        const auto flowDirection = mFlowDirections[navmapCoord.y * mNavmapSize + navmapCoord.x];
+        if (flowDirection == NO_FLOW_DIRECTION)
+        {
+            return false;
+        }
+        
+        outFacingDirection = static_cast<FacingDirection>(flowDirection);
+        return true;
+    }
+    
+    /// World space (positive up) unit direction to move along, or zero if there is none.
+    inline glm::vec3 GetFlowVector(const glm::ivec2& navmapCoord) const
+    {
+        FacingDirection facingDirection;
+        if (!GetFlowDirection(navmapCoord, facingDirection))
+        {
+            return glm::vec3(0.0f);
+        }
+        
+        const auto offset = GetNavmapCoordOffset(facingDirection);
+        return glm::normalize(glm::vec3(static_cast<float>(offset.x), static_cast<float>(-offset.y), 0.0f));
+    }
+    
+    /// Path cost to the goal, infinity for unreachable tiles.
+    inline float GetCostToGoal(const glm::ivec2& navmapCoord) const
+    {
+        return IsNavmapCoordInBounds(navmapCoord) ? mCostsToGoal[navmapCoord.y * mNavmapSize + navmapCoord.x] : std::numeric_limits<float>::infinity();
+    }
+    
+    inline bool IsReachable(const glm::ivec2& navmapCoord) const { return GetCostToGoal(navmapCoord) != std::numeric_limits<float>::infinity(); }
+    inline const glm::ivec2& GetGoalCoord() const { return mGoalCoord; }
+    inline bool IsBuilt() const { return mIsBuilt; }
+
+private:
+    struct OpenEntry
+    {
+        float mCostToGoal;
+        int mNodeIndex;
+    };
+    
+    static inline bool IsLowerPriorityOpenEntry(const OpenEntry& lhs, const OpenEntry& rhs)
+    {
+        return lhs.mCostToGoal > rhs.mCostToGoal || (lhs.mCostToGoal == rhs.mCostToGoal && lhs.mNodeIndex > rhs.mNodeIndex);
+    }
+    
+    inline void PushOpenEntry(const int nodeIndex, const float costToGoal)
+    {
+        mOpenHeap.push_back({ costToGoal, nodeIndex });
+        std::push_heap(mOpenHeap.begin(), mOpenHeap.end(), &NavmapFlowField::IsLowerPriorityOpenEntry);
+    }
+    
+    inline bool IsNavmapCoordInBounds(const glm::ivec2& navmapCoord) const
+    {
+        return navmapCoord.x >= 0 && navmapCoord.y >= 0 && navmapCoord.x < mNavmapSize && navmapCoord.y < mNavmapSize;
+    }
+
+private:
+    int mNavmapSize;
+    glm::ivec2 mGoalCoord;
+    bool mIsBuilt;
+    std::vector<float> mCostsToGoal;
+    std::vector<int8_t> mFlowDirections;
+    std::vector<OpenEntry> mOpenHeap;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Least recently used cache of flow fields keyed by goal tile, for one map.
+///
+/// When a goal moves by at most goalReuseTolerance tiles (e.g. a swarm chasing a player),
+/// the field of the old goal keeps being served while the field of the new goal is rebuilt
+/// over the next Update calls, within the given node budget, and then swapped in. A pending
+/// rebuild is not restarted for every further move of the goal (which would starve it when the
+/// goal moves every tick) but runs to completion as long as its goal stays within the tolerance,
+/// and is then retargeted at the most recently requested goal. Agents close to the goal should
+/// steer straight at the real target in the meantime.
+class NavmapFlowFieldCache final
+{
+public:
+    NavmapFlowFieldCache(const NavmapPathfinder& pathfinder, const size_t maxCachedFields = 4, const int goalReuseTolerance = 2)
+    : mPathfinder(pathfinder)
+    , mGoalReuseTolerance(goalReuseTolerance)
+    , mUseCounter(0)
+    {
+        mSlots.resize(math::Max(maxCachedFields, size_t(1)));
+    }
+    
+    inline const NavmapFlowField& GetFlowField(const glm::ivec2& goalCoord)
+    {
+        mUseCounter++;
+        
+        // Exact hits first (which also cancel a pending rebuild if the goal moved back)
+        for (auto& slot: mSlots)
+        {
+            if (slot.mLastUsed != 0 && slot.mFlowField.GetGoalCoord() == goalCoord)
+            {
+                slot.mLastUsed = mUseCounter;
+                slot.mRequestedGoalCoord = goalCoord;
+                slot.mHasPendingBuild = false;
+                return slot.mFlowField;
+            }
+        }
+        
+        FlowFieldSlot* nearestSlot = nullptr;
+        int nearestGoalDistance = mGoalReuseTolerance + 1;
+        for (auto& slot: mSlots)
+        {
+            const auto goalDistance = GetGoalDistance(slot.mFlowField.GetGoalCoord(), goalCoord);
+            if (slot.mLastUsed != 0 && goalDistance < nearestGoalDistance)
+            {
+                nearestSlot = &slot;
+                nearestGoalDistance = goalDistance;
+            }
+        }
+        
+        if (nearestSlot)
+        {
+            if (!nearestSlot->mHasPendingBuild || GetGoalDistance(nearestSlot->mPendingFlowField.GetGoalCoord(), goalCoord) > mGoalReuseTolerance)
+            {
+                nearestSlot->mPendingFlowField.BeginBuild(mPathfinder, goalCoord);
+                nearestSlot->mHasPendingBuild = true;
+            }
+            
+            nearestSlot->mRequestedGoalCoord = goalCoord;
+            nearestSlot->mLastUsed = mUseCounter;
+            return nearestSlot->mFlowField;
+        }
+        
+        auto& leastRecentlyUsedSlot = *std::min_element(mSlots.begin(), mSlots.end(), [](const FlowFieldSlot& lhs, const FlowFieldSlot& rhs){ return lhs.mLastUsed < rhs.mLastUsed; });
+        leastRecentlyUsedSlot.mFlowField.Build(mPathfinder, goalCoord);
+        leastRecentlyUsedSlot.mRequestedGoalCoord = goalCoord;
+        leastRecentlyUsedSlot.mHasPendingBuild = false;
+        leastRecentlyUsedSlot.mLastUsed = mUseCounter;
+        return leastRecentlyUsedSlot.mFlowField;
+    }
+    
+    /// Advances the pending rebuilds of moved goals, settling at most maxSettledNodes tiles in total.
+    inline void Update(const int maxSettledNodes)
+    {
+        auto remainingNodeBudget = maxSettledNodes;
+        for (auto& slot: mSlots)
+        {
+            while (slot.mHasPendingBuild && remainingNodeBudget > 0)
+            {
+                if (!slot.mPendingFlowField.ContinueBuild(mPathfinder, remainingNodeBudget))
+                {
+                    break;
+                }
+                
+                std::swap(slot.mFlowField, slot.mPendingFlowField);
+                slot.mHasPendingBuild = false;
+                
+                // The goal kept moving while the rebuild was running
+                if (slot.mRequestedGoalCoord != slot.mFlowField.GetGoalCoord())
+                {
+                    slot.mPendingFlowField.BeginBuild(mPathfinder, slot.mRequestedGoalCoord);
+                    slot.mHasPendingBuild = true;
+                }
+            }
+        }
+    }
+    
+    inline void Clear()
+    {
+        for (auto& slot: mSlots)
+        {
+            slot.mLastUsed = 0;
+            slot.mHasPendingBuild = false;
+        }
+    }
+
+private:
+    struct FlowFieldSlot
+    {
+        NavmapFlowField mFlowField;
+        NavmapFlowField mPendingFlowField;
+        glm::ivec2 mRequestedGoalCoord = glm::ivec2(0); // Goal of the last GetFlowField served by the slot
+        uint64_t mLastUsed = 0; // 0 for empty slots
+        bool mHasPendingBuild = false;
+    };
+    
+    static inline int GetGoalDistance(const glm::ivec2& lhsGoalCoord, const glm::ivec2& rhsGoalCoord)
+    {
+        return math::Max(std::abs(lhsGoalCoord.x - rhsGoalCoord.x), std::abs(lhsGoalCoord.y - rhsGoalCoord.y));
+    }
+    
+    const NavmapPathfinder& mPathfinder;
+    const int mGoalReuseTolerance;
+    uint64_t mUseCounter;
+    std::vector<FlowFieldSlot> mSlots;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* NavmapFlowField_h */
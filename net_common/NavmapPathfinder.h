@@ -0,0 +1,166 @@
+///------------------------------------------------------------------------------------------------
+///  NavmapPathfinder.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef NavmapPathfinder_h
+#define NavmapPathfinder_h
+
+///------------------------------------------------------------------------------------------------
+
+#if __has_include(<engine/utils/MathUtils.h>)
+#include <engine/utils/MathUtils.h>
+#else
+#include "../util/MathUtils.h"
+#endif
+
+#include <net_common/Navmap.h>
+#include <net_common/NetworkCommon.h>
+#include <net_common/NetStats.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline constexpr float IMPASSABLE_TILE_COST = -1.0f;
+inline constexpr float DIAGONAL_STEP_LENGTH = 1.41421356f;
+
+///------------------------------------------------------------------------------------------------
+
+enum class PathfindingAlgorithm
+{
+    AUTO,             // Jump point search when all passable tiles cost the same, A* otherwise
+    ASTAR,
+    JUMP_POINT_SEARCH // Requires uniform costs, falls back to A* otherwise
+};
+
+///------------------------------------------------------------------------------------------------
+
+struct PathfindingSettings
+{
+    // Cost of stepping onto a tile of each type (multiplied by sqrt(2) for diagonal steps),
+    // indexed by NavmapTileType. Negative costs make the tile type impassable.
+    float mTileTypeCosts[static_cast<int>(NavmapTileType::COUNT)] = { 1.0f, IMPASSABLE_TILE_COST, IMPASSABLE_TILE_COST };
+    
+    // Caps the number of expanded nodes per query (0 = unbounded), so that a single
+    // unreachable goal can't eat up a whole tick.
+    int mMaxExpandedNodes = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Open/closed set storage of a path query. Entries are invalidated by bumping the
+/// generation rather than clearing, so reusing the scratch across queries costs nothing.
+struct PathfindingScratch
+{
+    struct OpenEntry
+    {
+        float mEstimatedTotalCost;
+        int mNodeIndex;
+    };
+    
+    std::vector<float> mCostSoFar;
+    std::vector<int> mParentNodeIndices;
+    std::vector<uint32_t> mVisitedGenerations;
+    std::vector<uint32_t> mClosedGenerations;
+    std::vector<OpenEntry> mOpenHeap;
+    std::vector<int> mReversedNodePath;
+    uint32_t mGeneration = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline PathfindingScratch& GetThreadLocalPathfindingScratch()
+{
+    thread_local PathfindingScratch scratch;
+    return scratch;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Navmap coord step for each FacingDirection (navmap coords are positive down).
+inline glm::ivec2 GetNavmapCoordOffset(const FacingDirection facingDirection)
+{
+    switch (facingDirection)
+    {
+        case FacingDirection::SOUTH: return glm::ivec2(0, 1);
+        case FacingDirection::NORTH: return glm::ivec2(0, -1);
+        case FacingDirection::WEST: return glm::ivec2(-1, 0);
+        case FacingDirection::EAST: return glm::ivec2(1, 0);
+        case FacingDirection::NORTH_WEST: return glm::ivec2(-1, -1);
+        case FacingDirection::NORTH_EAST: return glm::ivec2(1, -1);
+        case FacingDirection::SOUTH_WEST: return glm::ivec2(-1, 1);
+        case FacingDirection::SOUTH_EAST: return glm::ivec2(1, 1);
+    }
+    
+    return glm::ivec2(0);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Shared grid pathfinder over a Navmap (or anything exposing GetSize and GetNavmapTileAt,
+/// e.g. the PackedNavmap). The per tile costs are resolved once on construction, so keep
+/// one pathfinder around per map and query it as often as needed; queries only touch the
+/// (per thread) scratch memory and the caller's output buffers.
+///
+/// Movement is 8 directional, matching FacingDirection, and diagonal steps are only allowed
+/// when both adjacent orthogonal tiles are passable (no corner cutting).
+class NavmapPathfinder final
+{
+public:
+    template<typename NavmapT>
+    NavmapPathfinder(const NavmapT& navmap, const PathfindingSettings& settings = PathfindingSettings());
+    
+    /// Fills outNavmapPath with every tile from startCoord to goalCoord (both inclusive).
+    /// Returns false (and leaves outNavmapPath empty) if there is no path.
+    bool FindPath(const glm::ivec2& startCoord, const glm::ivec2& goalCoord, std::vector<glm::ivec2>& outNavmapPath, const PathfindingAlgorithm algorithm = PathfindingAlgorithm::AUTO) const;
+    bool FindPath(const glm::ivec2& startCoord, const glm::ivec2& goalCoord, std::vector<glm::ivec2>& outNavmapPath, const PathfindingAlgorithm algorithm, PathfindingScratch& scratch) const;
+    
+    /// Drops the waypoints of a tile path that can be skipped by walking in a straight line,
+    /// without crossing impassable tiles, cutting corners or going through tiles more expensive
+    /// than the ones of the skipped stretch.
+    void SmoothPath(const std::vector<glm::ivec2>& navmapPath, std::vector<glm::ivec2>& outSmoothedPath) const;
+    
+    /// Converts a navmap path to world positions via GetMapPositionFromNavmapCoord.
+    template<typename NavmapT>
+    static void GetPathWorldPositions(const NavmapT& navmap, const std::vector<glm::ivec2>& navmapPath, const glm::vec2& mapPosition, const float mapScale, const float positionZ, std::vector<glm::vec3>& outPositions);
+    
+    bool IsPassable(const glm::ivec2& navmapCoord) const;
+    float GetTileCost(const glm::ivec2& navmapCoord) const;
+    bool HasUniformTileCosts() const;
+    int GetSize() const;
+
+private:
+    bool IsPassable(const int x, const int y) const;
+    bool CanStep(const int x, const int y, const int dx, const int dy) const;
+    float GetHeuristicCost(const int x, const int y, const int goalX, const int goalY) const;
+    void BeginQuery(PathfindingScratch& scratch) const;
+    void PushOpenEntry(PathfindingScratch& scratch, const int nodeIndex, const float estimatedTotalCost) const;
+    static bool IsLowerPriorityOpenEntry(const PathfindingScratch::OpenEntry& lhs, const PathfindingScratch::OpenEntry& rhs);
+    bool InternalFindPathAStar(const int startIndex, const int goalIndex, PathfindingScratch& scratch) const;
+    bool InternalFindPathJPS(const int startIndex, const int goalIndex, PathfindingScratch& scratch) const;
+    int JumpStraight(int x, int y, const int dx, const int dy, const int goalIndex) const;
+    int JumpDiagonal(int x, int y, const int dx, const int dy, const int goalIndex) const;
+    void ReconstructPath(const int goalIndex, PathfindingScratch& scratch, std::vector<glm::ivec2>& outNavmapPath) const;
+    bool HasLineOfSight(const glm::ivec2& fromCoord, const glm::ivec2& toCoord, const float maxTileCost) const;
+
+private:
+    const int mNavmapSize;
+    const int mMaxExpandedNodes;
+    std::vector<float> mTileCosts;
+    float mMinTileCost;
+    bool mHasUniformTileCosts;
+};
+
+///------------------------------------------------------------------------------------------------
+
+#include "NavmapPathfinder.inc"
+
+};
+
+#endif /* NavmapPathfinder_h */
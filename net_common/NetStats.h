@@ -0,0 +1,468 @@
+///------------------------------------------------------------------------------------------------
+///  NetStats.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef NET_STATS_H
+#define NET_STATS_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkCommon.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+///------------------------------------------------------------------------------------------------
+/// Built in counters are opt in, so that release servers don't pay for them. Define
+/// NET_COMMON_ENABLE_STATS=1 (the CMake option of the same name does it) to compile the
+/// NET_STATS_* hooks in; without it they expand to nothing and the snapshots stay empty.
+#ifndef NET_COMMON_ENABLE_STATS
+#define NET_COMMON_ENABLE_STATS 0
+#endif
+
+/// Reading the clock costs about as much as a small quadtree query, so the timers of the
+/// hottest queries only time one in this many of their scopes (per thread).
+#ifndef NET_COMMON_STATS_TIMER_SAMPLE_INTERVAL
+#define NET_COMMON_STATS_TIMER_SAMPLE_INTERVAL 16
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+#define BEGIN_MESSAGE(messageName) 1 +
+#define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity)
+#define STRING_FIELD(name, capacity)
+#define END_MESSAGE()
+
+/// Same as MessageType::UNUSED, without pulling in ENet via NetworkMessages.h.
+inline constexpr size_t NET_STATS_MESSAGE_TYPE_COUNT =
+#include <net_common/NetworkMessages.inc>
+0;
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+static_assert(NET_STATS_MESSAGE_TYPE_COUNT <= static_cast<size_t>(DEBUG_STATS_MAX_MESSAGE_TYPES));
+
+///------------------------------------------------------------------------------------------------
+
+enum class NetStatCounter : uint8_t
+{
+    QUADTREE_CANDIDATE_QUERIES,
+    QUADTREE_CANDIDATES,
+    QUADTREE_REGION_QUERIES,
+    QUADTREE_SEGMENT_QUERIES,
+    NAVMAP_PATH_QUERIES,
+    NAVMAP_PATHS_NOT_FOUND,
+    NAVMAP_RAYCASTS,
+    NAVMAP_FLOW_FIELD_BUILDS,
+    COUNT
+};
+
+static_assert(static_cast<int>(NetStatCounter::COUNT) <= DEBUG_STATS_MAX_COUNTERS);
+
+///------------------------------------------------------------------------------------------------
+
+enum class NetStatHistogram : uint8_t
+{
+    QUADTREE_CANDIDATES_PER_QUERY,
+    QUADTREE_CANDIDATE_QUERY_NANOS,
+    QUADTREE_SEGMENT_QUERY_NANOS,
+    NAVMAP_PATH_QUERY_NANOS,
+    NAVMAP_PATH_LENGTH,
+    NAVMAP_FLOW_FIELD_SLICE_NANOS,
+    COUNT
+};
+
+static_assert(static_cast<int>(NetStatHistogram::COUNT) <= DEBUG_STATS_MAX_HISTOGRAMS);
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* GetNetStatCounterName(const NetStatCounter counter)
+{
+    switch (counter)
+    {
+        case NetStatCounter::QUADTREE_CANDIDATE_QUERIES: return "QUADTREE_CANDIDATE_QUERIES";
+        case NetStatCounter::QUADTREE_CANDIDATES: return "QUADTREE_CANDIDATES";
+        case NetStatCounter::QUADTREE_REGION_QUERIES: return "QUADTREE_REGION_QUERIES";
+        case NetStatCounter::QUADTREE_SEGMENT_QUERIES: return "QUADTREE_SEGMENT_QUERIES";
+        case NetStatCounter::NAVMAP_PATH_QUERIES: return "NAVMAP_PATH_QUERIES";
+        case NetStatCounter::NAVMAP_PATHS_NOT_FOUND: return "NAVMAP_PATHS_NOT_FOUND";
+        case NetStatCounter::NAVMAP_RAYCASTS: return "NAVMAP_RAYCASTS";
+        case NetStatCounter::NAVMAP_FLOW_FIELD_BUILDS: return "NAVMAP_FLOW_FIELD_BUILDS";
+        case NetStatCounter::COUNT: break;
+    }
+    
+    return "UNKNOWN";
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline const char* GetNetStatHistogramName(const NetStatHistogram histogram)
+{
+    switch (histogram)
+    {
+        case NetStatHistogram::QUADTREE_CANDIDATES_PER_QUERY: return "QUADTREE_CANDIDATES_PER_QUERY";
+        case NetStatHistogram::QUADTREE_CANDIDATE_QUERY_NANOS: return "QUADTREE_CANDIDATE_QUERY_NANOS";
+        case NetStatHistogram::QUADTREE_SEGMENT_QUERY_NANOS: return "QUADTREE_SEGMENT_QUERY_NANOS";
+        case NetStatHistogram::NAVMAP_PATH_QUERY_NANOS: return "NAVMAP_PATH_QUERY_NANOS";
+        case NetStatHistogram::NAVMAP_PATH_LENGTH: return "NAVMAP_PATH_LENGTH";
+        case NetStatHistogram::NAVMAP_FLOW_FIELD_SLICE_NANOS: return "NAVMAP_FLOW_FIELD_SLICE_NANOS";
+        case NetStatHistogram::COUNT: break;
+    }
+    
+    return "UNKNOWN";
+}
+
+///------------------------------------------------------------------------------------------------
+/// Power of two bucket of a histogram value, see DebugStatsRequestData.
+inline int GetNetStatsHistogramBucket(const uint64_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long highestBit = 0;
+    _BitScanReverse64(&highestBit, value);
+    const auto bitWidth = static_cast<int>(highestBit) + 1;
+#elif defined(__GNUC__) || defined(__clang__)
+    const auto bitWidth = 64 - __builtin_clzll(value);
+#else
+    auto remaining = value;
+    int bitWidth = 0;
+    for (; remaining != 0; ++bitWidth)
+    {
+        remaining >>= 1;
+    }
+#endif
+
+    return bitWidth < DEBUG_STATS_HISTOGRAM_BUCKET_COUNT ? bitWidth : DEBUG_STATS_HISTOGRAM_BUCKET_COUNT - 1;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Counters of a single thread. Only the owning thread writes them, so increments are plain
+/// relaxed load + store pairs (no locked read-modify-write); the atomics are only there so that
+/// snapshots taken from another thread read whole values.
+struct NetStatsThreadCounters
+{
+    std::atomic<uint64_t> mMessagesSent[NET_STATS_MESSAGE_TYPE_COUNT] = {};
+    std::atomic<uint64_t> mBytesSent[NET_STATS_MESSAGE_TYPE_COUNT] = {};
+    std::atomic<uint64_t> mMessagesReceived[NET_STATS_MESSAGE_TYPE_COUNT] = {};
+    std::atomic<uint64_t> mBytesReceived[NET_STATS_MESSAGE_TYPE_COUNT] = {};
+    std::atomic<uint64_t> mCounters[static_cast<size_t>(NetStatCounter::COUNT)] = {};
+    std::atomic<uint64_t> mHistogramBuckets[static_cast<size_t>(NetStatHistogram::COUNT)][DEBUG_STATS_HISTOGRAM_BUCKET_COUNT] = {};
+    uint32_t mTimerSampleCountdown = 0; // Owning thread only, never snapshotted
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline void AddNetStatsValue(std::atomic<uint64_t>& counter, const uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Process wide list of the live per thread counters, plus the totals of the threads that have
+/// exited since. Counters only ever grow; diff two snapshots to get rates.
+class NetStatsRegistry final
+{
+public:
+    static NetStatsRegistry& GetInstance()
+    {
+        static NetStatsRegistry instance;
+        return instance;
+    }
+    
+    inline void RegisterThreadCounters(NetStatsThreadCounters* threadCounters)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mThreadCounters.push_back(threadCounters);
+    }
+    
+    inline void UnregisterThreadCounters(NetStatsThreadCounters* threadCounters)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        AccumulateThreadCounters(*threadCounters, mRetiredTotals);
+        
+        for (auto& registeredCounters: mThreadCounters)
+        {
+            if (registeredCounters == threadCounters)
+            {
+                registeredCounters = mThreadCounters.back();
+                mThreadCounters.pop_back();
+                break;
+            }
+        }
+    }
+    
+    /// Fills the counter part of outStatsData; the quadtree shape is filled by
+    /// NetworkQuadtree::FillDebugStatsRequestData.
+    inline void GetSnapshot(DebugStatsRequestData& outStatsData)
+    {
+        outStatsData.messageTypeCount = static_cast<uint32_t>(NET_STATS_MESSAGE_TYPE_COUNT);
+        outStatsData.counterCount = static_cast<uint32_t>(NetStatCounter::COUNT);
+        outStatsData.histogramCount = static_cast<uint32_t>(NetStatHistogram::COUNT);
+        outStatsData.isStatsEnabled = NET_COMMON_ENABLE_STATS != 0;
+        
+        std::lock_guard<std::mutex> lock(mMutex);
+        CopyTotals(mRetiredTotals, outStatsData);
+        for (const auto* threadCounters: mThreadCounters)
+        {
+            DebugStatsRequestData threadTotals;
+            AccumulateThreadCounters(*threadCounters, threadTotals);
+            AddTotals(threadTotals, outStatsData);
+        }
+    }
+
+private:
+    NetStatsRegistry() = default;
+    
+    static void AccumulateThreadCounters(const NetStatsThreadCounters& threadCounters, DebugStatsRequestData& totals)
+    {
+        for (size_t i = 0; i < NET_STATS_MESSAGE_TYPE_COUNT; ++i)
+        {
+            totals.messagesSent[i] += threadCounters.mMessagesSent[i].load(std::memory_order_relaxed);
+            totals.bytesSent[i] += threadCounters.mBytesSent[i].load(std::memory_order_relaxed);
+            totals.messagesReceived[i] += threadCounters.mMessagesReceived[i].load(std::memory_order_relaxed);
+            totals.bytesReceived[i] += threadCounters.mBytesReceived[i].load(std::memory_order_relaxed);
+        }
+        
+        for (size_t i = 0; i < static_cast<size_t>(NetStatCounter::COUNT); ++i)
+        {
+            totals.counters[i] += threadCounters.mCounters[i].load(std::memory_order_relaxed);
+        }
+        
+        for (size_t i = 0; i < static_cast<size_t>(NetStatHistogram::COUNT); ++i)
+        {
+            for (int bucket = 0; bucket < DEBUG_STATS_HISTOGRAM_BUCKET_COUNT; ++bucket)
+            {
+                totals.histogramBuckets[i][bucket] += threadCounters.mHistogramBuckets[i][bucket].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    static void CopyTotals(const DebugStatsRequestData& totals, DebugStatsRequestData& outStatsData)
+    {
+        std::copy(std::begin(totals.messagesSent), std::end(totals.messagesSent), outStatsData.messagesSent);
+        std::copy(std::begin(totals.bytesSent), std::end(totals.bytesSent), outStatsData.bytesSent);
+        std::copy(std::begin(totals.messagesReceived), std::end(totals.messagesReceived), outStatsData.messagesReceived);
+        std::copy(std::begin(totals.bytesReceived), std::end(totals.bytesReceived), outStatsData.bytesReceived);
+        std::copy(std::begin(totals.counters), std::end(totals.counters), outStatsData.counters);
+        std::copy(&totals.histogramBuckets[0][0], &totals.histogramBuckets[0][0] + DEBUG_STATS_MAX_HISTOGRAMS * DEBUG_STATS_HISTOGRAM_BUCKET_COUNT, &outStatsData.histogramBuckets[0][0]);
+    }
+    
+    static void AddTotals(const DebugStatsRequestData& totals, DebugStatsRequestData& outStatsData)
+    {
+        for (int i = 0; i < DEBUG_STATS_MAX_MESSAGE_TYPES; ++i)
+        {
+            outStatsData.messagesSent[i] += totals.messagesSent[i];
+            outStatsData.bytesSent[i] += totals.bytesSent[i];
+            outStatsData.messagesReceived[i] += totals.messagesReceived[i];
+            outStatsData.bytesReceived[i] += totals.bytesReceived[i];
+        }
+        
+        for (int i = 0; i < DEBUG_STATS_MAX_COUNTERS; ++i)
+        {
+            outStatsData.counters[i] += totals.counters[i];
+        }
+        
+        for (int i = 0; i < DEBUG_STATS_MAX_HISTOGRAMS; ++i)
+        {
+            for (int bucket = 0; bucket < DEBUG_STATS_HISTOGRAM_BUCKET_COUNT; ++bucket)
+            {
+                outStatsData.histogramBuckets[i][bucket] += totals.histogramBuckets[i][bucket];
+            }
+        }
+    }
+
+private:
+    std::mutex mMutex;
+    std::vector<NetStatsThreadCounters*> mThreadCounters;
+    DebugStatsRequestData mRetiredTotals;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Registers the calling thread's counters on first use, and folds them into the registry's
+/// retired totals when the thread exits.
+class NetStatsThreadCountersHandle final
+{
+public:
+    NetStatsThreadCountersHandle()
+    : mThreadCounters(std::make_unique<NetStatsThreadCounters>())
+    {
+        NetStatsRegistry::GetInstance().RegisterThreadCounters(mThreadCounters.get());
+    }
+    
+    ~NetStatsThreadCountersHandle()
+    {
+        NetStatsRegistry::GetInstance().UnregisterThreadCounters(mThreadCounters.get());
+    }
+    
+    NetStatsThreadCountersHandle(const NetStatsThreadCountersHandle&) = delete;
+    NetStatsThreadCountersHandle& operator=(const NetStatsThreadCountersHandle&) = delete;
+    
+    inline NetStatsThreadCounters& GetThreadCounters() { return *mThreadCounters; }
+
+private:
+    std::unique_ptr<NetStatsThreadCounters> mThreadCounters;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline NetStatsThreadCounters& GetThreadLocalNetStats()
+{
+    thread_local NetStatsThreadCountersHandle handle;
+    return handle.GetThreadCounters();
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void AddNetStatsCounter(const NetStatCounter counter, const uint64_t value)
+{
+    AddNetStatsValue(GetThreadLocalNetStats().mCounters[static_cast<size_t>(counter)], value);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void RecordNetStatsHistogram(const NetStatHistogram histogram, const uint64_t value)
+{
+    AddNetStatsValue(GetThreadLocalNetStats().mHistogramBuckets[static_cast<size_t>(histogram)][GetNetStatsHistogramBucket(value)], 1);
+}
+
+///------------------------------------------------------------------------------------------------
+/// Takes the first byte of the message, which is its type in the full header format, and its
+/// type plus the sequence flag (the high bit) in the compact one. Unknown types are not counted.
+inline void RecordNetStatsMessageSent(const uint8_t messageTypeByte, const size_t messageSize)
+{
+    const auto messageType = static_cast<size_t>(messageTypeByte & 0x7F);
+    if (messageType < NET_STATS_MESSAGE_TYPE_COUNT)
+    {
+        auto& threadCounters = GetThreadLocalNetStats();
+        AddNetStatsValue(threadCounters.mMessagesSent[messageType], 1);
+        AddNetStatsValue(threadCounters.mBytesSent[messageType], messageSize);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+/// Received messages are counted by DispatchMessage, so compact messages show up with the size
+/// of the full message they were rebuilt into.
+inline void RecordNetStatsMessageReceived(const uint8_t messageTypeByte, const size_t messageSize)
+{
+    const auto messageType = static_cast<size_t>(messageTypeByte & 0x7F);
+    if (messageType < NET_STATS_MESSAGE_TYPE_COUNT)
+    {
+        auto& threadCounters = GetThreadLocalNetStats();
+        AddNetStatsValue(threadCounters.mMessagesReceived[messageType], 1);
+        AddNetStatsValue(threadCounters.mBytesReceived[messageType], messageSize);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+/// Records the nanoseconds spent in its scope into a histogram. With a sampleInterval above 1,
+/// only one in sampleInterval timers of the thread reads the clock and records its time.
+class NetStatsScopedTimer final
+{
+public:
+    NetStatsScopedTimer(const NetStatHistogram histogram, const uint32_t sampleInterval = 1)
+    : mThreadCounters(GetThreadLocalNetStats())
+    , mHistogram(histogram)
+    , mIsSampled(IsNextTimerSampled(mThreadCounters, sampleInterval))
+    , mStartTime(mIsSampled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+    {
+    }
+    
+    ~NetStatsScopedTimer()
+    {
+        if (mIsSampled)
+        {
+            const auto elapsedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStartTime).count();
+            AddNetStatsValue(mThreadCounters.mHistogramBuckets[static_cast<size_t>(mHistogram)][GetNetStatsHistogramBucket(static_cast<uint64_t>(elapsedNanos))], 1);
+        }
+    }
+    
+    NetStatsScopedTimer(const NetStatsScopedTimer&) = delete;
+    NetStatsScopedTimer& operator=(const NetStatsScopedTimer&) = delete;
+    
+private:
+    static bool IsNextTimerSampled(NetStatsThreadCounters& threadCounters, const uint32_t sampleInterval)
+    {
+        if (sampleInterval <= 1)
+        {
+            return true;
+        }
+        
+        if (threadCounters.mTimerSampleCountdown == 0)
+        {
+            threadCounters.mTimerSampleCountdown = sampleInterval - 1;
+            return true;
+        }
+        
+        threadCounters.mTimerSampleCountdown--;
+        return false;
+    }
+    
+private:
+    NetStatsThreadCounters& mThreadCounters;
+    const NetStatHistogram mHistogram;
+    const bool mIsSampled;
+    const std::chrono::steady_clock::time_point mStartTime;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline void GetNetStatsSnapshot(DebugStatsRequestData& outStatsData)
+{
+    NetStatsRegistry::GetInstance().GetSnapshot(outStatsData);
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+/// Hooks used by the hot paths. Their arguments are not evaluated at all when stats are off.
+#define NET_STATS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define NET_STATS_CONCAT(lhs, rhs) NET_STATS_CONCAT_IMPL(lhs, rhs)
+
+#if NET_COMMON_ENABLE_STATS
+#define NET_STATS_ADD(counter, value) network::AddNetStatsCounter(counter, value)
+#define NET_STATS_RECORD(histogram, value) network::RecordNetStatsHistogram(histogram, value)
+#define NET_STATS_SCOPED_TIMER(histogram) const network::NetStatsScopedTimer NET_STATS_CONCAT(netStatsScopedTimer, __LINE__)(histogram)
+#define NET_STATS_SAMPLED_SCOPED_TIMER(histogram) const network::NetStatsScopedTimer NET_STATS_CONCAT(netStatsScopedTimer, __LINE__)(histogram, NET_COMMON_STATS_TIMER_SAMPLE_INTERVAL)
+#define NET_STATS_MESSAGE_SENT(messageData, messageSize) network::RecordNetStatsMessageSent(static_cast<const unsigned char*>(messageData)[0], messageSize)
+#define NET_STATS_MESSAGE_RECEIVED(messageData, messageSize) network::RecordNetStatsMessageReceived(static_cast<const unsigned char*>(messageData)[0], messageSize)
+#else
+#define NET_STATS_ADD(counter, value) ((void)0)
+#define NET_STATS_RECORD(histogram, value) ((void)0)
+#define NET_STATS_SCOPED_TIMER(histogram) ((void)0)
+#define NET_STATS_SAMPLED_SCOPED_TIMER(histogram) ((void)0)
+#define NET_STATS_MESSAGE_SENT(messageData, messageSize) ((void)0)
+#define NET_STATS_MESSAGE_RECEIVED(messageData, messageSize) ((void)0)
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+#endif // NET_STATS_H
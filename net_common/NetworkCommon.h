@@ -128,24 +128,60 @@ struct ObjectData
 
 ///------------------------------------------------------------------------------------------------
 
-struct DebugQuadtreeRequestData
+inline constexpr int MAX_DEBUG_QUADTREE_RECTS_PER_MESSAGE = 512;
+inline constexpr int MAX_DEBUG_PATH_POSITIONS = 128;
+
+///------------------------------------------------------------------------------------------------
+
+struct DebugQuadtreeRect
 {
-    glm::vec3 debugRectPositions[512] = {};
-    glm::vec3 debugRectDimensions[512] = {};
-    size_t debugRectCount;
+    glm::vec3 position;
+    glm::vec3 dimensions;
 };
 
 ///------------------------------------------------------------------------------------------------
 
-struct DebugObjectPathRequestData
+inline constexpr int DEBUG_STATS_MAX_MESSAGE_TYPES = 64;
+inline constexpr int DEBUG_STATS_MAX_COUNTERS = 16;
+inline constexpr int DEBUG_STATS_MAX_HISTOGRAMS = 8;
+inline constexpr int DEBUG_STATS_HISTOGRAM_BUCKET_COUNT = 32;
+
+///------------------------------------------------------------------------------------------------
+/// Snapshot of the NetStats.h counters. Histogram bucket 0 counts zeros, and bucket i > 0 counts
+/// values in [2^(i-1), 2^i), with the last bucket also taking everything above it.
+struct DebugStatsRequestData
 {
-    glm::vec3 debugPathPositions[128] = {};
-    size_t debugPathPositionsCount;
+    uint64_t messagesSent[DEBUG_STATS_MAX_MESSAGE_TYPES] = {};
+    uint64_t bytesSent[DEBUG_STATS_MAX_MESSAGE_TYPES] = {};
+    uint64_t messagesReceived[DEBUG_STATS_MAX_MESSAGE_TYPES] = {};
+    uint64_t bytesReceived[DEBUG_STATS_MAX_MESSAGE_TYPES] = {};
+    uint64_t counters[DEBUG_STATS_MAX_COUNTERS] = {};
+    uint64_t histogramBuckets[DEBUG_STATS_MAX_HISTOGRAMS][DEBUG_STATS_HISTOGRAM_BUCKET_COUNT] = {};
+    
+    // Shape of the server's quadtree at the time of the snapshot
+    uint64_t quadtreeObjectsPerNodeBuckets[DEBUG_STATS_HISTOGRAM_BUCKET_COUNT] = {};
+    uint32_t quadtreeNodeCount = 0;
+    uint32_t quadtreeLeafCount = 0;
+    uint32_t quadtreeMaxDepth = 0;
+    uint32_t quadtreeObjectCount = 0;
+    
+    uint32_t messageTypeCount = 0;
+    uint32_t counterCount = 0;
+    uint32_t histogramCount = 0;
+    bool isStatsEnabled = false;
 };
 
 ///------------------------------------------------------------------------------------------------
+/// The collision checks in this namespace take anything with ObjectData's position, objectScale
+/// and colliderData members (e.g. an ObjectColliderView of an ObjectTable). The ObjectData
+/// versions below forward to them.
+namespace collision
+{
 
-inline bool RectToRectIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+///------------------------------------------------------------------------------------------------
+
+template<typename LhsObjectT, typename RhsObjectT>
+inline bool RectToRectIntersectionCheck(const LhsObjectT& lhs, const RhsObjectT& rhs)
 {
     glm::vec2 lhsTopLeft(lhs.position.x - (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.x)/2.0f, lhs.position.y + (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.y)/2.0f);
     glm::vec2 lhsBotRight(lhs.position.x + (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.x)/2.0f, lhs.position.y - (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.y)/2.0f);
@@ -158,7 +194,8 @@ inline bool RectToRectIntersectionCheck(const ObjectData& lhs, const ObjectData&
 
 ///------------------------------------------------------------------------------------------------
 
-inline bool RectToCircleIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+template<typename LhsObjectT, typename RhsObjectT>
+inline bool RectToCircleIntersectionCheck(const LhsObjectT& lhs, const RhsObjectT& rhs)
 {
     glm::vec2 lhsTopLeft(lhs.position.x - (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.x)/2.0f, lhs.position.y + (lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.y)/2.0f);
     
@@ -173,7 +210,8 @@ inline bool RectToCircleIntersectionCheck(const ObjectData& lhs, const ObjectDat
 
 ///------------------------------------------------------------------------------------------------
 
-inline bool CircleToCircleIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+template<typename LhsObjectT, typename RhsObjectT>
+inline bool CircleToCircleIntersectionCheck(const LhsObjectT& lhs, const RhsObjectT& rhs)
 {
     const auto& centerDistanceSquared = ((lhs.position.x - rhs.position.x) * (lhs.position.x - rhs.position.x) + (lhs.position.y - rhs.position.y) * (lhs.position.y - rhs.position.y));
     const auto& radiusSumSquared = ((lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.x)/2.0f + (rhs.objectScale * rhs.colliderData.colliderRelativeDimensions.x)/2.0f) * ((lhs.objectScale * lhs.colliderData.colliderRelativeDimensions.x)/2.0f + (rhs.objectScale * rhs.colliderData.colliderRelativeDimensions.x)/2.0f);
@@ -182,7 +220,8 @@ inline bool CircleToCircleIntersectionCheck(const ObjectData& lhs, const ObjectD
 
 ///------------------------------------------------------------------------------------------------
 
-inline bool CollidersIntersect(const ObjectData& lhs, const ObjectData& rhs)
+template<typename LhsObjectT, typename RhsObjectT>
+inline bool CollidersIntersect(const LhsObjectT& lhs, const RhsObjectT& rhs)
 {
     if (lhs.colliderData.colliderType == ColliderType::RECTANGLE)
     {
@@ -196,6 +235,38 @@ inline bool CollidersIntersect(const ObjectData& lhs, const ObjectData& rhs)
 
 ///------------------------------------------------------------------------------------------------
 
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline bool RectToRectIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+{
+    return collision::RectToRectIntersectionCheck(lhs, rhs);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline bool RectToCircleIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+{
+    return collision::RectToCircleIntersectionCheck(lhs, rhs);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline bool CircleToCircleIntersectionCheck(const ObjectData& lhs, const ObjectData& rhs)
+{
+    return collision::CircleToCircleIntersectionCheck(lhs, rhs);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline bool CollidersIntersect(const ObjectData& lhs, const ObjectData& rhs)
+{
+    return collision::CollidersIntersect(lhs, rhs);
+}
+
+///------------------------------------------------------------------------------------------------
+
 inline std::string GetCurrentMapString(const ObjectData& objectData)
 {
     return std::string(objectData.currentMap);
@@ -10,9 +10,17 @@
 
 ///------------------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <enet/enet.h>
 #include <net_common/NetworkCommon.h>
+#include <net_common/NetStats.h>
+#include <net_common/ObjectDataDelta.h>
 #include <net_common/Version.h>
 
 #if __has_include(<engine/utils/MathUtils.h>)
@@ -31,6 +39,8 @@ namespace network
 /// Define Message Types
 #define BEGIN_MESSAGE(messageName) messageName,
 #define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity)
+#define STRING_FIELD(name, capacity)
 #define END_MESSAGE()
 
 enum class MessageType : uint8_t
@@ -41,15 +51,50 @@ enum class MessageType : uint8_t
 
 #undef BEGIN_MESSAGE
 #undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
 #undef END_MESSAGE
 
+/// Besides plain FIELDs, messages can have length prefixed arrays, ARRAY_FIELD(name, type, capacity),
+/// and bounded strings, STRING_FIELD(name, capacity). In the message struct an array is a name##Count
+/// followed by capacity elements, and a string is a null terminated char[capacity] (capacity <= 256).
+/// Messages with either are variable length: on the wire their fields are packed back to back, with
+/// arrays as a 16 bit count plus their live elements and strings as an 8 bit length plus their
+/// characters (see WriteMessage/ReadMessage). All other messages go on the wire as their struct.
+#define BEGIN_MESSAGE(messageName) (false
+#define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity) || true
+#define STRING_FIELD(name, capacity) || true
+#define END_MESSAGE() ),
+
+inline constexpr bool VARIABLE_LENGTH_MESSAGES[] =
+{
+#include <net_common/NetworkMessages.inc>
+};
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+inline constexpr bool IsVariableLengthMessage(const MessageType messageType)
+{
+    return messageType < MessageType::UNUSED && VARIABLE_LENGTH_MESSAGES[static_cast<size_t>(messageType)];
+}
+
 struct MessageHeader {
     MessageType type;
     char version[16];
 };
 
-#define BEGIN_MESSAGE(messageName) struct messageName { MessageHeader __header { MessageType::messageName, NET_COMMON_VERSION };
+#define BEGIN_MESSAGE(messageName) struct messageName { \
+    static constexpr MessageType MESSAGE_TYPE = MessageType::messageName; \
+    static constexpr bool IS_VARIABLE_LENGTH = IsVariableLengthMessage(MessageType::messageName); \
+    MessageHeader __header { MessageType::messageName, NET_COMMON_VERSION };
 #define FIELD(name, type) type name;
+#define ARRAY_FIELD(name, type, capacity) static_assert(capacity <= 0xFFFF); uint16_t name##Count = 0; type name[capacity];
+#define STRING_FIELD(name, capacity) static_assert(capacity > 0 && capacity <= 256); char name[capacity] = {};
 #define END_MESSAGE() };
 
 #include <net_common/NetworkMessages.inc>
@@ -62,16 +107,370 @@ static constexpr enet_uint32 RELIABLE = 1;
 
 inline void SendMessage(ENetPeer* toPeer, const void* message, const size_t messageSize, const enet_uint32 channel)
 {
+    NET_STATS_MESSAGE_SENT(message, messageSize);
     ENetPacket* enetPacket = enet_packet_create(message, messageSize, channel);
     enet_peer_send(toPeer, channel, enetPacket);
 }
 
 inline void BroadcastMessage(ENetHost* server, const void* message, const size_t messageSize, const enet_uint32 channel)
 {
+    NET_STATS_MESSAGE_SENT(message, messageSize);
     ENetPacket* enetPacket = enet_packet_create(message, messageSize, channel);
     enet_host_broadcast(server, channel, enetPacket);
 }
 
+/// Sends an already created packet to a subset of peers. ENet reference counts the packet across
+/// the peers, so the payload is only allocated and copied once. Packets that no peer accepted
+/// (e.g. all of them were disconnecting) are destroyed here.
+inline void MulticastPacket(ENetPeer* const* toPeers, const size_t peerCount, ENetPacket* enetPacket, const enet_uint32 channel)
+{
+    NET_STATS_MESSAGE_SENT(enetPacket->data, enetPacket->dataLength);
+    
+    for (size_t i = 0; i < peerCount; ++i)
+    {
+        enet_peer_send(toPeers[i], channel, enetPacket);
+    }
+    
+    if (enetPacket->referenceCount == 0)
+    {
+        enet_packet_destroy(enetPacket);
+    }
+}
+
+/// Encode-once fan-out of a message to a subset of peers (e.g. the viewers of an object), as
+/// opposed to SendMessage per peer which creates and copies a packet for each of them.
+inline void MulticastMessage(ENetPeer* const* toPeers, const size_t peerCount, const void* message, const size_t messageSize, const enet_uint32 channel)
+{
+    if (peerCount == 0)
+    {
+        return;
+    }
+    
+    MulticastPacket(toPeers, peerCount, enet_packet_create(message, messageSize, channel), channel);
+}
+
+/// ObjectStateDeltaUpdateMessages only carry the live part of their payload on the wire.
+inline size_t GetObjectStateDeltaUpdateMessageSize(const ObjectStateDeltaUpdateMessage& message)
+{
+    return offsetof(ObjectStateDeltaUpdateMessage, deltaData) + offsetof(ObjectDeltaData, payload) + message.deltaData.payloadSize;
+}
+
+inline bool ReadObjectStateDeltaUpdateMessage(const unsigned char* rawMessageData, const size_t rawMessageSize, ObjectStateDeltaUpdateMessage& outMessage)
+{
+    const auto minMessageSize = offsetof(ObjectStateDeltaUpdateMessage, deltaData) + offsetof(ObjectDeltaData, payload);
+    if (rawMessageSize < minMessageSize || rawMessageSize > sizeof(ObjectStateDeltaUpdateMessage))
+    {
+        return false;
+    }
+    
+    std::memcpy(&outMessage, rawMessageData, rawMessageSize);
+    return outMessage.deltaData.payloadSize <= MAX_OBJECT_DELTA_PAYLOAD_SIZE && GetObjectStateDeltaUpdateMessageSize(outMessage) == rawMessageSize;
+}
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+/// Message struct sizes indexed by MessageType, and the offset of their first field right after
+/// the MessageHeader (padding included). Messages without fields return their size as the offset.
+#define BEGIN_MESSAGE(messageName) sizeof(messageName),
+#define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity)
+#define STRING_FIELD(name, capacity)
+#define END_MESSAGE()
+
+inline constexpr size_t MESSAGE_SIZES[] =
+{
+#include <net_common/NetworkMessages.inc>
+};
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+static_assert(sizeof(MESSAGE_SIZES)/sizeof(MESSAGE_SIZES[0]) == static_cast<size_t>(MessageType::UNUSED));
+static_assert(NET_STATS_MESSAGE_TYPE_COUNT == static_cast<size_t>(MessageType::UNUSED));
+
+inline constexpr size_t GetMessageSize(const MessageType messageType)
+{
+    return messageType < MessageType::UNUSED ? MESSAGE_SIZES[static_cast<size_t>(messageType)] : 0;
+}
+
+#define BEGIN_MESSAGE(messageName) case MessageType::messageName: { using CurrentMessageT = messageName; size_t fieldsOffset = sizeof(CurrentMessageT);
+#define FIELD(name, type) fieldsOffset = math::Min(fieldsOffset, static_cast<size_t>(offsetof(CurrentMessageT, name)));
+#define ARRAY_FIELD(name, type, capacity) fieldsOffset = math::Min(fieldsOffset, static_cast<size_t>(offsetof(CurrentMessageT, name##Count)));
+#define STRING_FIELD(name, capacity) fieldsOffset = math::Min(fieldsOffset, static_cast<size_t>(offsetof(CurrentMessageT, name)));
+#define END_MESSAGE() return fieldsOffset; }
+
+inline size_t GetMessageFieldsOffset(const MessageType messageType)
+{
+    switch (messageType)
+    {
+#include <net_common/NetworkMessages.inc>
+        default: break;
+    }
+    
+    return 0;
+}
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+/// Message names, e.g. for labelling the per message type counters of a DebugStatsRequestData.
+#define BEGIN_MESSAGE(messageName) #messageName,
+#define FIELD(name, type)
+#define ARRAY_FIELD(name, type, capacity)
+#define STRING_FIELD(name, capacity)
+#define END_MESSAGE()
+
+inline constexpr const char* MESSAGE_TYPE_NAMES[] =
+{
+#include <net_common/NetworkMessages.inc>
+};
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+inline const char* GetMessageTypeName(const MessageType messageType)
+{
+    return messageType < MessageType::UNUSED ? MESSAGE_TYPE_NAMES[static_cast<size_t>(messageType)] : "UNUSED";
+}
+
+/// Packed field serialization of the variable length messages, generated for every message but
+/// only used for the variable length ones. Callers size outData with GetPackedFieldsSize.
+namespace message_serialization
+{
+
+inline size_t GetBoundedStringLength(const char* string, const size_t capacity)
+{
+    size_t length = 0;
+    while (length + 1 < capacity && string[length] != '\0')
+    {
+        length++;
+    }
+    
+    return length;
+}
+
+#define BEGIN_MESSAGE(messageName) inline size_t GetPackedFieldsSize(const messageName& message) { (void)message; size_t packedSize = 0;
+#define FIELD(name, type) packedSize += sizeof(type);
+#define ARRAY_FIELD(name, type, capacity) packedSize += sizeof(uint16_t) + static_cast<size_t>(message.name##Count) * sizeof(type);
+#define STRING_FIELD(name, capacity) packedSize += sizeof(uint8_t) + GetBoundedStringLength(message.name, capacity);
+#define END_MESSAGE() return packedSize; }
+
+#include <net_common/NetworkMessages.inc>
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+/// Returns the number of bytes written, or 0 for arrays whose count exceeds their capacity.
+#define BEGIN_MESSAGE(messageName) inline size_t WritePackedFields(const messageName& message, unsigned char* outData) { (void)message; auto* writeData = outData;
+#define FIELD(name, type) std::memcpy(writeData, &message.name, sizeof(type)); writeData += sizeof(type);
+#define ARRAY_FIELD(name, type, capacity) \
+    if (message.name##Count > (capacity)) { return 0; } \
+    std::memcpy(writeData, &message.name##Count, sizeof(uint16_t)); writeData += sizeof(uint16_t); \
+    std::memcpy(writeData, message.name, message.name##Count * sizeof(type)); writeData += message.name##Count * sizeof(type);
+#define STRING_FIELD(name, capacity) \
+    { \
+        const auto length = GetBoundedStringLength(message.name, capacity); \
+        *writeData++ = static_cast<unsigned char>(length); \
+        std::memcpy(writeData, message.name, length); writeData += length; \
+    }
+#define END_MESSAGE() return static_cast<size_t>(writeData - outData); }
+
+#include <net_common/NetworkMessages.inc>
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+/// Validates every length against the remaining data and the field's capacity, and that the
+/// packed fields use up the data exactly. Array elements past the count are left untouched.
+#define BEGIN_MESSAGE(messageName) inline bool ReadPackedFields(const unsigned char* data, const size_t dataSize, messageName& outMessage) { (void)data; (void)outMessage; size_t readOffset = 0;
+#define FIELD(name, type) \
+    if (dataSize - readOffset < sizeof(type)) { return false; } \
+    std::memcpy(&outMessage.name, data + readOffset, sizeof(type)); readOffset += sizeof(type);
+#define ARRAY_FIELD(name, type, capacity) \
+    if (dataSize - readOffset < sizeof(uint16_t)) { return false; } \
+    std::memcpy(&outMessage.name##Count, data + readOffset, sizeof(uint16_t)); readOffset += sizeof(uint16_t); \
+    if (outMessage.name##Count > (capacity) || (dataSize - readOffset) / sizeof(type) < outMessage.name##Count) { return false; } \
+    std::memcpy(outMessage.name, data + readOffset, outMessage.name##Count * sizeof(type)); readOffset += outMessage.name##Count * sizeof(type);
+#define STRING_FIELD(name, capacity) \
+    { \
+        if (dataSize - readOffset < sizeof(uint8_t)) { return false; } \
+        const size_t length = data[readOffset++]; \
+        if (length >= (capacity) || dataSize - readOffset < length) { return false; } \
+        std::memcpy(outMessage.name, data + readOffset, length); readOffset += length; \
+        std::memset(outMessage.name + length, 0, (capacity) - length); \
+    }
+#define END_MESSAGE() return readOffset == dataSize; }
+
+#include <net_common/NetworkMessages.inc>
+
+#undef BEGIN_MESSAGE
+#undef FIELD
+#undef ARRAY_FIELD
+#undef STRING_FIELD
+#undef END_MESSAGE
+
+}
+
+/// Bytes of a message on the wire in the full header format.
+template<typename MessageT>
+inline size_t GetMessageWireSize(const MessageT& message)
+{
+    if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        return GetMessageFieldsOffset(MessageT::MESSAGE_TYPE) + message_serialization::GetPackedFieldsSize(message);
+    }
+    else
+    {
+        return sizeof(MessageT);
+    }
+}
+
+inline size_t GetMessageWireSize(const ObjectStateDeltaUpdateMessage& message)
+{
+    return GetObjectStateDeltaUpdateMessageSize(message);
+}
+
+/// Writes a message in the full header format. Returns the number of bytes written, or 0 if the
+/// message doesn't fit in outData or one of its arrays holds more elements than its capacity.
+template<typename MessageT>
+inline size_t WriteMessage(const MessageT& message, unsigned char* outData, const size_t outDataCapacity)
+{
+    const auto wireSize = GetMessageWireSize(message);
+    if (wireSize > outDataCapacity)
+    {
+        return 0;
+    }
+    
+    if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        const auto fieldsOffset = GetMessageFieldsOffset(MessageT::MESSAGE_TYPE);
+        std::memcpy(outData, &message, fieldsOffset);
+        return message_serialization::WritePackedFields(message, outData + fieldsOffset) != 0 ? wireSize : 0;
+    }
+    else
+    {
+        std::memcpy(outData, &message, wireSize);
+        return wireSize;
+    }
+}
+
+/// Reads a message in the full header format, as written by WriteMessage (or sent as a struct).
+template<typename MessageT>
+inline bool ReadMessage(const unsigned char* messageData, const size_t messageSize, MessageT& outMessage)
+{
+    if (messageSize == 0 || messageData[0] != static_cast<uint8_t>(MessageT::MESSAGE_TYPE))
+    {
+        return false;
+    }
+    
+    if constexpr (MessageT::IS_VARIABLE_LENGTH)
+    {
+        const auto fieldsOffset = GetMessageFieldsOffset(MessageT::MESSAGE_TYPE);
+        if (messageSize < fieldsOffset)
+        {
+            return false;
+        }
+        
+        std::memcpy(&outMessage, messageData, fieldsOffset);
+        return message_serialization::ReadPackedFields(messageData + fieldsOffset, messageSize - fieldsOffset, outMessage);
+    }
+    else if constexpr (std::is_same_v<MessageT, ObjectStateDeltaUpdateMessage>)
+    {
+        return ReadObjectStateDeltaUpdateMessage(messageData, messageSize, outMessage);
+    }
+    else
+    {
+        if (messageSize != sizeof(MessageT))
+        {
+            return false;
+        }
+        
+        std::memcpy(&outMessage, messageData, sizeof(MessageT));
+        return true;
+    }
+}
+
+/// Typed send in the full header format, which is required for variable length messages. The
+/// message is written straight into the packet, so it's only copied once. Returns false if the
+/// message could not be written (see WriteMessage).
+template<typename MessageT>
+inline bool SendMessage(ENetPeer* toPeer, const MessageT& message, const enet_uint32 channel)
+{
+    const auto wireSize = GetMessageWireSize(message);
+    ENetPacket* enetPacket = enet_packet_create(nullptr, wireSize, channel);
+    if (enetPacket == nullptr)
+    {
+        return false;
+    }
+    
+    if (WriteMessage(message, enetPacket->data, wireSize) == 0)
+    {
+        enet_packet_destroy(enetPacket);
+        return false;
+    }
+    
+    NET_STATS_MESSAGE_SENT(enetPacket->data, wireSize);
+    enet_peer_send(toPeer, channel, enetPacket);
+    return true;
+}
+
+/// Debug quadtree rectangles (e.g. from NetworkQuadtree::GetDebugRenderRectangles) are spread over
+/// as many responses as needed. Fills the response with the rectangles from firstRectIndex onwards
+/// and returns the index of the first one that didn't fit, so the whole tree is sent with:
+///
+///     size_t nextRectIndex = 0;
+///     do
+///     {
+///         nextRectIndex = FillDebugGetQuadtreeResponse(debugRectangles, nextRectIndex, response);
+///         SendMessage(peer, response, channels::RELIABLE);
+///     } while (nextRectIndex < debugRectangles.size());
+inline size_t FillDebugGetQuadtreeResponse(const std::vector<std::pair<glm::vec3, glm::vec3>>& debugRectangles, const size_t firstRectIndex, DebugGetQuadtreeResponseMessage& outResponse)
+{
+    const auto rectCount = math::Min(debugRectangles.size() - math::Min(firstRectIndex, debugRectangles.size()), static_cast<size_t>(MAX_DEBUG_QUADTREE_RECTS_PER_MESSAGE));
+    
+    outResponse.firstRectIndex = static_cast<uint32_t>(firstRectIndex);
+    outResponse.totalRectCount = static_cast<uint32_t>(debugRectangles.size());
+    outResponse.debugRectsCount = static_cast<uint16_t>(rectCount);
+    for (size_t i = 0; i < rectCount; ++i)
+    {
+        outResponse.debugRects[i].position = debugRectangles[firstRectIndex + i].first;
+        outResponse.debugRects[i].dimensions = debugRectangles[firstRectIndex + i].second;
+    }
+    
+    return firstRectIndex + rectCount;
+}
+
+/// Returns false if the path has more positions than a response can hold, in which case it
+/// carries the first MAX_DEBUG_PATH_POSITIONS of them and totalPathPositionCount the full length.
+inline bool FillDebugGetObjectPathResponse(const std::vector<glm::vec3>& pathPositions, DebugGetObjectPathResponseMessage& outResponse)
+{
+    const auto positionCount = math::Min(pathPositions.size(), static_cast<size_t>(MAX_DEBUG_PATH_POSITIONS));
+    
+    outResponse.totalPathPositionCount = static_cast<uint32_t>(pathPositions.size());
+    outResponse.debugPathPositionsCount = static_cast<uint16_t>(positionCount);
+    std::copy(pathPositions.begin(), pathPositions.begin() + positionCount, outResponse.debugPathPositions);
+    return positionCount == pathPositions.size();
+}
+
 enum class MessageVersionValidityEnum
 {
     VALID,
@@ -79,25 +478,94 @@ enum class MessageVersionValidityEnum
     INCOMING_MESSAGE_AHEAD_IN_VERSION
 };
 
-inline MessageVersionValidityEnum GetMessageVersionValidity(unsigned char* rawMessageData)
+/// NET_COMMON_VERSION as numbers, so that e.g. 1.1.100 correctly compares ahead of 1.1.99.
+struct NetCommonVersion
+{
+    uint16_t major = 0;
+    uint16_t minor = 0;
+    uint16_t patch = 0;
+};
+
+/// Parses "major.minor.patch" out of at most maxLength characters (stopping at a null terminator).
+inline bool ParseNetCommonVersion(const char* versionString, const size_t maxLength, NetCommonVersion& outVersion)
 {
-    static std::string CURRENT_VERSION(NET_COMMON_VERSION);
+    uint32_t components[3] = {};
+    int componentIndex = 0;
+    bool componentHasDigits = false;
     
-    const char* incomingVersion = reinterpret_cast<const char*>(rawMessageData + 1);
-    const auto& cmpResult = CURRENT_VERSION.compare(std::string(incomingVersion, strnlen(incomingVersion, 16)));
+    size_t i = 0;
+    for (; i < maxLength && versionString[i] != '\0'; ++i)
+    {
+        const auto character = versionString[i];
+        if (character >= '0' && character <= '9')
+        {
+            components[componentIndex] = components[componentIndex] * 10 + static_cast<uint32_t>(character - '0');
+            componentHasDigits = true;
+            if (components[componentIndex] > 0xFFFF)
+            {
+                return false;
+            }
+        }
+        else if (character == '.' && componentHasDigits && componentIndex < 2)
+        {
+            componentIndex++;
+            componentHasDigits = false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    
+    if (componentIndex != 2 || !componentHasDigits)
+    {
+        return false;
+    }
+    
+    outVersion.major = static_cast<uint16_t>(components[0]);
+    outVersion.minor = static_cast<uint16_t>(components[1]);
+    outVersion.patch = static_cast<uint16_t>(components[2]);
+    return true;
+}
 
-    if (!cmpResult)
+inline const NetCommonVersion& GetCurrentNetCommonVersion()
+{
+    static const NetCommonVersion CURRENT_VERSION = []()
+    {
+        NetCommonVersion currentVersion;
+        ParseNetCommonVersion(NET_COMMON_VERSION, sizeof(NET_COMMON_VERSION), currentVersion);
+        return currentVersion;
+    }();
+    
+    return CURRENT_VERSION;
+}
+
+inline MessageVersionValidityEnum GetVersionValidity(const NetCommonVersion& incomingVersion)
+{
+    const auto& currentVersion = GetCurrentNetCommonVersion();
+    const uint64_t currentVersionKey = (uint64_t(currentVersion.major) << 32) | (uint64_t(currentVersion.minor) << 16) | currentVersion.patch;
+    const uint64_t incomingVersionKey = (uint64_t(incomingVersion.major) << 32) | (uint64_t(incomingVersion.minor) << 16) | incomingVersion.patch;
+    
+    if (currentVersionKey == incomingVersionKey)
     {
         return MessageVersionValidityEnum::VALID;
     }
-    else if (cmpResult > 0)
+    
+    return currentVersionKey > incomingVersionKey ? MessageVersionValidityEnum::INCOMING_MESSAGE_BEHIND_IN_VERSION : MessageVersionValidityEnum::INCOMING_MESSAGE_AHEAD_IN_VERSION;
+}
+
+/// Validates the version string of a message sent with the full MessageHeader. Peers that went
+/// through the handshake in CompactMessages.h only need this for their handshake message.
+inline MessageVersionValidityEnum GetMessageVersionValidity(const unsigned char* rawMessageData)
+{
+    NetCommonVersion incomingVersion;
+    if (!ParseNetCommonVersion(reinterpret_cast<const char*>(rawMessageData + offsetof(MessageHeader, version)), sizeof(MessageHeader::version), incomingVersion))
     {
+        // Unparseable versions can only come from (very) old peers
         return MessageVersionValidityEnum::INCOMING_MESSAGE_BEHIND_IN_VERSION;
     }
-    else
-    {
-        return MessageVersionValidityEnum::INCOMING_MESSAGE_AHEAD_IN_VERSION;
-    }
+    
+    return GetVersionValidity(incomingVersion);
 }
 
 inline const char* GetMessageVersionValidityString(const MessageVersionValidityEnum value)
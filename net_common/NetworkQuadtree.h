@@ -17,6 +17,10 @@
 #endif
 
 #include <net_common/NetworkCommon.h>
+#include <net_common/NetStats.h>
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
 #include <vector>
 
 ///-----------------------------------------------------------------------------------------------
@@ -26,41 +30,127 @@ namespace network
 
 ///-----------------------------------------------------------------------------------------------
 
+class ObjectTable;
+
+///-----------------------------------------------------------------------------------------------
+
+inline constexpr int MAX_OBJECTS_PER_NODE = 2;
+inline constexpr int MAX_DEPTH = 5;
+inline constexpr size_t NO_OBJECT_INDEX = static_cast<size_t>(-1);
+
+///-----------------------------------------------------------------------------------------------
+
 class NetworkQuadtree final
 {
 public:
-    NetworkQuadtree(const glm::vec3& origin, const glm::vec3& dimensions, const int depth = 0);
+    NetworkQuadtree(const glm::vec3& origin, const glm::vec3& dimensions, const int maxObjectsPerNode = MAX_OBJECTS_PER_NODE, const int maxDepth = MAX_DEPTH);
     ~NetworkQuadtree();
     
     const glm::vec3& GetOrigin() const;
     const glm::vec3& GetDimensions() const;
     std::vector<objectId_t> GetCollisionCandidates(const ObjectData& objectData) const;
-    void InsertObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions);
+    void InsertObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions, const size_t objectIndex = NO_OBJECT_INDEX);
     void PopulateSceneGraph(const std::vector<ObjectData>& netObjectData);
+    void PopulateSceneGraph(const ObjectTable& objectTable);
     void Clear();
+    
+    // Incremental maintenance, as an alternative to Clear + PopulateSceneGraph every tick.
+    // Both return false for unknown objects, and expect object ids to be unique in the tree.
+    bool RemoveObject(const objectId_t objectId);
+    bool UpdateObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions);
+    
+    // Allocation free broadphase. The buffer overload clears and reuses the caller's buffer.
+    // Visitor signature: void(const objectId_t candidateObjectId)
+    void GetCollisionCandidates(const ObjectData& objectData, std::vector<objectId_t>& outCollisionCandidates) const;
+    template<typename VisitorT> void ForEachCollisionCandidate(const ObjectData& objectData, VisitorT&& visitor) const;
+    
+    // Single tree walk reporting every pair of objects with overlapping collider rectangles exactly once.
+    // Visitor signature: void(const objectId_t lhsObjectId, const objectId_t rhsObjectId)
+    template<typename VisitorT> void FindAllCandidatePairs(VisitorT&& visitor) const;
+    
+    // Same as above with CollidersIntersect run inline as the narrow phase. netObjectData must be the
+    // vector the tree was populated from (objects inserted without an objectIndex are skipped).
+    // Visitor signature: void(const ObjectData& lhs, const ObjectData& rhs)
+    template<typename VisitorT> void FindAllCollidingPairs(const std::vector<ObjectData>& netObjectData, VisitorT&& visitor) const;
+    
+    // Same as above for trees populated from an ObjectTable.
+    // Visitor signature: void(const size_t lhsObjectIndex, const size_t rhsObjectIndex)
+    template<typename VisitorT> void FindAllCollidingPairs(const ObjectTable& objectTable, VisitorT&& visitor) const;
+    
+    // Per node slices of the pair walk above, so that it can be split across threads (see ParallelCollisions.h).
+    // The pairs reported from all the nodes returned by CollectNodes are exactly the pairs of FindAllCollidingPairs.
+    void CollectNodes(std::vector<const NetworkQuadtree*>& outNodes) const;
+    template<typename VisitorT> void FindNodeCollidingPairs(const std::vector<ObjectData>& netObjectData, VisitorT&& visitor) const;
+    template<typename VisitorT> void FindNodeCollidingPairs(const ObjectTable& objectTable, VisitorT&& visitor) const;
+    
     int GetMatchedQuadrant(const glm::vec3& objectPosition, const glm::vec3& objectDimensions) const;
+    
+    // Range queries. Objects whose collider rectangle overlaps (or touches) the query region are reported.
+    void GetObjectsInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, std::vector<objectId_t>& outObjectIds) const;
+    void GetObjectsInRadius(const glm::vec3& center, const float radius, std::vector<objectId_t>& outObjectIds) const;
+    
+    // Visitor signature: void(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+    template<typename VisitorT> void ForEachObjectInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, VisitorT&& visitor) const;
+    template<typename VisitorT> void ForEachObjectInRadius(const glm::vec3& center, const float radius, VisitorT&& visitor) const;
+    
+    // Segment query. Objects whose collider rectangle, grown by sweepRadius on every side, is crossed by the segment are
+    // reported with the segment parameter in [0, 1] at which it's entered (0 if start is already inside). Nodes are walked
+    // in the order the segment crosses them, and the visitor returns the parameter past which the walk can stop (e.g. the
+    // earliest time of impact so far, or 1.0f to see every crossed object). See SweptQueries.h.
+    // Visitor signature: float(const objectId_t objectId, const size_t objectIndex, const float timeOfImpact)
+    template<typename VisitorT> void ForEachObjectAlongSegment(const glm::vec3& start, const glm::vec3& end, const float sweepRadius, VisitorT&& visitor) const;
 
     std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugRenderRectangles() const;
+    
+    // Fills the quadtree shape fields (node, leaf and object counts, depth, objects per node) of a stats snapshot.
+    // The counters are filled by GetNetStatsSnapshot (see NetStats.h).
+    void FillDebugStatsRequestData(DebugStatsRequestData& outStatsData) const;
+    
     std::string GetFullMatchedQuadrantPositionString(const glm::vec3& objectPosition, const glm::vec3& objectDimensions) const;
 
 private:
     struct QuadtreeEntityEntry
     {
-        QuadtreeEntityEntry(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+        QuadtreeEntityEntry(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions, const size_t objectIndex)
             : mObjectId(objectId)
             , mObjectPosition(position)
             , mObjectDimensions(dimensions)
+            , mObjectIndex(objectIndex)
         {
         }
         
         objectId_t mObjectId;
         glm::vec3 mObjectPosition;
         glm::vec3 mObjectDimensions;
+        size_t mObjectIndex; // Index in the PopulateSceneGraph input, if any
     };
     
+    // Child node constructor, used by Split
+    NetworkQuadtree(const glm::vec3& origin, const glm::vec3& dimensions, const int maxObjectsPerNode, const int maxDepth, const int depth);
+    
     void InternalClear();
-    void InternalGetCollisionCandidates(const ObjectData& objectData, std::vector<objectId_t>& collisionCandidates) const;
+    void InternalBuildObjectNodeIndex(std::unordered_map<objectId_t, NetworkQuadtree*>& objectNodeIndex);
+    void InternalRemoveObjectEntry(const size_t entryIndex);
+    void InternalMergeChildren(NetworkQuadtree* mergeTarget);
+    void TryMergeUpwards();
+    bool IsRoutedToThisNode(const glm::vec3& position, const glm::vec3& dimensions) const;
+    NetworkQuadtree* FindObjectNode(const objectId_t objectId);
+    template<typename VisitorT>
+    void InternalForEachCollisionCandidate(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions, VisitorT& visitor) const;
+    template<typename VisitorT>
+    void InternalFindAllCandidatePairs(VisitorT& visitor) const;
+    template<typename VisitorT>
+    void InternalFindNodeCandidatePairs(VisitorT& visitor) const;
+    template<typename VisitorT>
+    void InternalFindEntryOverlapsInSubtree(const QuadtreeEntityEntry& entry, VisitorT& visitor) const;
+    static bool EntriesOverlap(const QuadtreeEntityEntry& lhs, const QuadtreeEntityEntry& rhs);
+    template<typename OverlapPredicateT, typename VisitorT>
+    void InternalForEachObjectInRegion(const glm::vec2& regionMin, const glm::vec2& regionMax, OverlapPredicateT& overlapPredicate, VisitorT& visitor) const;
+    template<typename VisitorT>
+    void InternalForEachObjectAlongSegment(const glm::vec2& start, const glm::vec2& delta, const float sweepRadius, const float nodeMinTime, const float nodeMaxTime, float& maxTime, VisitorT& visitor) const;
+    static bool ClipSegmentToHalfSpace(const float start, const float delta, const float bound, const bool isBelowBound, float& minTime, float& maxTime);
     void InternalGetDebugRenderRectangles(std::vector<std::pair<glm::vec3, glm::vec3>>& debugRectangles) const;
+    void InternalFillDebugStatsRequestData(DebugStatsRequestData& outStatsData) const;
     void InternalGetMatchedQuadrantPositionString(const glm::vec3& objectPosition, const glm::vec3& objectDimensions, std::string& positionString) const;
     void Split();
     
@@ -68,13 +158,31 @@ private:
     const glm::vec3 mOrigin;
     const glm::vec3 mDimensions;
     const int mDepth;
+    const int mMaxObjectsPerNode;
+    const int mMaxDepth;
     
+    NetworkQuadtree* mRoot;
+    NetworkQuadtree* mParent;
     std::unique_ptr<NetworkQuadtree> mNodes[4];
     std::vector<QuadtreeEntityEntry> mObjectsInNode;
+    size_t mSubtreeObjectCount;
+    
+    // Only used by the root node, and only built on the first incremental call so that
+    // users of the Clear + PopulateSceneGraph cycle don't pay for it.
+    std::unordered_map<objectId_t, NetworkQuadtree*> mObjectNodeIndex;
+    bool mIsObjectNodeIndexBuilt;
 };
 
 ///------------------------------------------------------------------------------------------------
 
+}
+
+// Only the definitions of the ObjectTable overloads need the complete type
+#include <net_common/ObjectTable.h>
+
+namespace network
+{
+
 #include "NetworkQuadtree.inc"
 
 };
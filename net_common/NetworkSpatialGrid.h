@@ -0,0 +1,132 @@
+///------------------------------------------------------------------------------------------------
+///  NetworkSpatialGrid.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef NetworkSpatialGrid_h
+#define NetworkSpatialGrid_h
+
+///------------------------------------------------------------------------------------------------
+
+#if __has_include(<engine/utils/MathUtils.h>)
+#include <engine/utils/MathUtils.h>
+#else
+#include "../util/MathUtils.h"
+#endif
+
+#include <net_common/NetworkCommon.h>
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/ObjectTable.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+///-----------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///-----------------------------------------------------------------------------------------------
+
+inline const float SPATIAL_GRID_CELL_SIZE = MAP_TILE_SIZE * 2.0f;
+
+///-----------------------------------------------------------------------------------------------
+/// Uniform grid broadphase with the same candidate query surface as the NetworkQuadtree, so
+/// that servers can pick the backend per map. Meant for maps where swarms of small, similarly
+/// sized colliders bunch up, which is where the quadtree degrades (objects straddling split
+/// lines pile up in the inner nodes).
+///
+/// Every object lives in the single cell containing its position, and queries widen their
+/// cell range by the largest collider half extent. Objects bigger than a cell in either axis
+/// are kept in a separate list instead, so that one big collider doesn't widen every query.
+/// The cells are rebuilt from scratch with a counting sort in O(N), with no allocations once
+/// warmed up, so there is no incremental Remove/UpdateObject: just rebuild every tick.
+///
+/// Unlike the quadtree, collision candidates are only the objects whose collider rectangles
+/// overlap (or touch) the query's, so the candidate lists are tighter.
+class NetworkSpatialGrid final
+{
+public:
+    NetworkSpatialGrid(const glm::vec3& origin, const glm::vec3& dimensions, const float cellSize = SPATIAL_GRID_CELL_SIZE);
+    
+    const glm::vec3& GetOrigin() const;
+    const glm::vec3& GetDimensions() const;
+    float GetCellSize() const;
+    glm::ivec2 GetCellCount() const;
+    size_t GetObjectCount() const;
+    
+    // InsertObject only stages the object; it becomes visible to queries on the next RebuildCells
+    // (PopulateSceneGraph inserts and rebuilds in one go).
+    void InsertObject(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions, const size_t objectIndex = NO_OBJECT_INDEX);
+    void RebuildCells();
+    void PopulateSceneGraph(const std::vector<ObjectData>& netObjectData);
+    void PopulateSceneGraph(const ObjectTable& objectTable);
+    void Clear();
+    
+    // Visitor signature: void(const objectId_t candidateObjectId)
+    std::vector<objectId_t> GetCollisionCandidates(const ObjectData& objectData) const;
+    void GetCollisionCandidates(const ObjectData& objectData, std::vector<objectId_t>& outCollisionCandidates) const;
+    template<typename VisitorT> void ForEachCollisionCandidate(const ObjectData& objectData, VisitorT&& visitor) const;
+    
+    // Visitor signature: void(const objectId_t lhsObjectId, const objectId_t rhsObjectId)
+    template<typename VisitorT> void FindAllCandidatePairs(VisitorT&& visitor) const;
+    
+    // Visitor signature: void(const ObjectData& lhs, const ObjectData& rhs)
+    template<typename VisitorT> void FindAllCollidingPairs(const std::vector<ObjectData>& netObjectData, VisitorT&& visitor) const;
+    
+    // Visitor signature: void(const size_t lhsObjectIndex, const size_t rhsObjectIndex)
+    template<typename VisitorT> void FindAllCollidingPairs(const ObjectTable& objectTable, VisitorT&& visitor) const;
+    
+    void GetObjectsInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, std::vector<objectId_t>& outObjectIds) const;
+    void GetObjectsInRadius(const glm::vec3& center, const float radius, std::vector<objectId_t>& outObjectIds) const;
+    
+    // Visitor signature: void(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+    template<typename VisitorT> void ForEachObjectInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, VisitorT&& visitor) const;
+    template<typename VisitorT> void ForEachObjectInRadius(const glm::vec3& center, const float radius, VisitorT&& visitor) const;
+    
+    // Occupied cells only
+    std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugRenderRectangles() const;
+
+private:
+    struct GridEntry
+    {
+        objectId_t mObjectId;
+        glm::vec3 mObjectPosition;
+        glm::vec3 mObjectDimensions;
+        size_t mObjectIndex; // Index in the PopulateSceneGraph input, if any
+    };
+    
+    int GetCellColumn(const float x) const;
+    int GetCellRow(const float y) const;
+    template<typename VisitorT>
+    void InternalForEachEntryInRegion(const glm::vec2& regionMin, const glm::vec2& regionMax, VisitorT& visitor) const;
+    template<typename VisitorT>
+    void InternalFindAllCandidatePairs(VisitorT& visitor) const;
+    static bool EntriesOverlap(const GridEntry& lhs, const GridEntry& rhs);
+    static bool EntryOverlapsRegion(const GridEntry& entry, const glm::vec2& regionMin, const glm::vec2& regionMax);
+
+private:
+    const glm::vec3 mOrigin;
+    const glm::vec3 mDimensions;
+    const float mCellSize;
+    const float mInverseCellSize;
+    const glm::vec2 mGridMin;
+    const int mColumnCount;
+    const int mRowCount;
+    
+    std::vector<GridEntry> mStagedEntries;
+    std::vector<int> mStagedEntryCells;
+    std::vector<GridEntry> mEntries;         // Sorted by cell, followed by the oversized entries
+    std::vector<int> mCellEntryStarts;       // Bucket starts, the oversized bucket and the end last
+    size_t mOversizedEntryStart;
+    glm::vec2 mMaxCellEntryHalfExtents;
+};
+
+///------------------------------------------------------------------------------------------------
+
+#include "NetworkSpatialGrid.inc"
+
+};
+#endif /* NetworkSpatialGrid_h */
@@ -0,0 +1,572 @@
+///------------------------------------------------------------------------------------------------
+///  ObjectDataDelta.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef OBJECT_DATA_DELTA_H
+#define OBJECT_DATA_DELTA_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/BitStream.h>
+#include <net_common/NetworkCommon.h>
+#include <cmath>
+#include <unordered_map>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+// Positions and velocities travel as fixed point with 1/65536 world unit resolution.
+// Power of two scales keep the dequantize -> requantize round trip exact on both ends.
+// The fixed point values are 32 bit, so the representable range is [-32768, 32768) world
+// units; values outside of it are clamped to the nearest end (see QuantizeDeltaValue).
+inline constexpr float DELTA_POSITION_QUANTIZATION_SCALE = 65536.0f;
+inline constexpr float DELTA_VELOCITY_QUANTIZATION_SCALE = 65536.0f;
+
+inline constexpr int MAX_OBJECT_DELTA_PAYLOAD_SIZE = 256;
+inline constexpr uint32_t OBJECT_DELTA_HISTORY_SIZE = 32;
+inline constexpr uint32_t NO_DELTA_BASELINE = 0; // Never used as a sequence, see GetNextObjectDeltaSequence
+
+///------------------------------------------------------------------------------------------------
+
+namespace object_delta_fields
+{
+static constexpr uint32_t POSITION              = 1 << 0;
+static constexpr uint32_t VELOCITY              = 1 << 1;
+static constexpr uint32_t FACING_AND_STATE      = 1 << 2;
+static constexpr uint32_t ACTION_TIMER          = 1 << 3;
+static constexpr uint32_t CURRENT_HEALTH        = 1 << 4;
+static constexpr uint32_t SPEED_AND_SCALE       = 1 << 5;
+static constexpr uint32_t TYPE_ENUMS            = 1 << 6;
+static constexpr uint32_t COLLIDER_DIMENSIONS   = 1 << 7;
+static constexpr uint32_t MAX_HEALTH_AND_DAMAGE = 1 << 8;
+static constexpr uint32_t PARENT_OBJECT_ID      = 1 << 9;
+static constexpr uint32_t DISPLAY_NAME          = 1 << 10;
+static constexpr uint32_t CURRENT_MAP           = 1 << 11;
+};
+
+///------------------------------------------------------------------------------------------------
+
+namespace object_delta_enum_bits
+{
+static constexpr int OBJECT_TYPE      = 2;
+static constexpr int ATTACK_TYPE      = 2;
+static constexpr int PROJECTILE_TYPE  = 1;
+static constexpr int OBJECT_FACTION   = 2;
+static constexpr int COLLIDER_TYPE    = 1;
+static constexpr int FACING_DIRECTION = 3;
+static constexpr int OBJECT_STATE     = 3;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Wire payload of an ObjectStateDeltaUpdateMessage. Only the first payloadSize bytes
+/// of the payload are sent (see GetObjectStateDeltaUpdateMessageSize).
+/// A baselineSequence of NO_DELTA_BASELINE marks a keyframe, i.e. a delta against a
+/// default constructed ObjectData.
+struct ObjectDeltaData
+{
+    objectId_t objectId;
+    uint32_t sequence;
+    uint32_t baselineSequence;
+    uint16_t payloadSize;
+    uint8_t payload[MAX_OBJECT_DELTA_PAYLOAD_SIZE];
+};
+
+///------------------------------------------------------------------------------------------------
+/// Canonical (quantized) form of an ObjectData that both ends agree on. This is what
+/// the server keeps per peer as a baseline, so names are only kept as hashes.
+struct ObjectDeltaState
+{
+    objectId_t parentObjectId = 0;
+    health_t maxHealthPoints = 0;
+    health_t currentHealthPoints = 0;
+    health_t damagePoints = 0;
+    int32_t position[3] = {};
+    int32_t velocity[3] = {};
+    glm::vec2 colliderRelativeDimensions = glm::vec2(0.0f);
+    float speed = 0.0f;
+    float objectScale = 0.0f;
+    float actionTimer = 0.0f;
+    uint32_t motionEnums = 0;
+    uint32_t typeEnums = 0;
+    uint64_t displayNameHash = 0;
+    uint64_t currentMapHash = 0;
+};
+
+///------------------------------------------------------------------------------------------------
+
+inline int32_t QuantizeDeltaValue(const float value, const float scale)
+{
+    // Clamped rather than wrapped, as 2^31 itself is not representable. The upper bound is the
+    // largest float below 2^31.
+    const auto scaledValue = math::Max(-2147483648.0f, math::Min(value * scale, 2147483520.0f));
+    return static_cast<int32_t>(std::lround(scaledValue));
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline float DequantizeDeltaValue(const int32_t value, const float scale)
+{
+    return static_cast<float>(value) / scale;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline int32_t CanonicalizeDeltaValue(const int32_t value, const float scale)
+{
+    // What the receiving end will get back when requantizing its own (float) copy
+    return QuantizeDeltaValue(DequantizeDeltaValue(value, scale), scale);
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline uint64_t GetDeltaStringHash(const char* str, const size_t maxLength)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < maxLength && str[i]; ++i)
+    {
+        hash = (hash ^ static_cast<uint8_t>(str[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline uint32_t PackMotionEnums(const ObjectData& objectData)
+{
+    return static_cast<uint32_t>(objectData.facingDirection) |
+           static_cast<uint32_t>(objectData.objectState) << object_delta_enum_bits::FACING_DIRECTION;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline uint32_t PackTypeEnums(const ObjectData& objectData)
+{
+    using namespace object_delta_enum_bits;
+    
+    uint32_t packedEnums = static_cast<uint32_t>(objectData.objectType);
+    packedEnums |= static_cast<uint32_t>(objectData.attackType) << OBJECT_TYPE;
+    packedEnums |= static_cast<uint32_t>(objectData.projectileType) << (OBJECT_TYPE + ATTACK_TYPE);
+    packedEnums |= static_cast<uint32_t>(objectData.objectFaction) << (OBJECT_TYPE + ATTACK_TYPE + PROJECTILE_TYPE);
+    packedEnums |= static_cast<uint32_t>(objectData.colliderData.colliderType) << (OBJECT_TYPE + ATTACK_TYPE + PROJECTILE_TYPE + OBJECT_FACTION);
+    return packedEnums;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void UnpackMotionEnums(const uint32_t packedEnums, ObjectData& objectData)
+{
+    using namespace object_delta_enum_bits;
+    
+    objectData.facingDirection = static_cast<FacingDirection>(packedEnums & ((1u << FACING_DIRECTION) - 1));
+    objectData.objectState = static_cast<ObjectState>((packedEnums >> FACING_DIRECTION) & ((1u << OBJECT_STATE) - 1));
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void UnpackTypeEnums(uint32_t packedEnums, ObjectData& objectData)
+{
+    using namespace object_delta_enum_bits;
+    
+    objectData.objectType = static_cast<ObjectType>(packedEnums & ((1u << OBJECT_TYPE) - 1));
+    packedEnums >>= OBJECT_TYPE;
+    objectData.attackType = static_cast<AttackType>(packedEnums & ((1u << ATTACK_TYPE) - 1));
+    packedEnums >>= ATTACK_TYPE;
+    objectData.projectileType = static_cast<ProjectileType>(packedEnums & ((1u << PROJECTILE_TYPE) - 1));
+    packedEnums >>= PROJECTILE_TYPE;
+    objectData.objectFaction = static_cast<ObjectFaction>(packedEnums & ((1u << OBJECT_FACTION) - 1));
+    packedEnums >>= OBJECT_FACTION;
+    objectData.colliderData.colliderType = static_cast<ColliderType>(packedEnums & ((1u << COLLIDER_TYPE) - 1));
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline ObjectDeltaState CreateObjectDeltaState(const ObjectData& objectData)
+{
+    ObjectDeltaState state;
+    state.parentObjectId = objectData.parentObjectId;
+    state.maxHealthPoints = objectData.maxHealthPoints;
+    state.currentHealthPoints = objectData.currentHealthPoints;
+    state.damagePoints = objectData.damagePoints;
+    for (int i = 0; i < 3; ++i)
+    {
+        state.position[i] = CanonicalizeDeltaValue(QuantizeDeltaValue(objectData.position[i], DELTA_POSITION_QUANTIZATION_SCALE), DELTA_POSITION_QUANTIZATION_SCALE);
+        state.velocity[i] = CanonicalizeDeltaValue(QuantizeDeltaValue(objectData.velocity[i], DELTA_VELOCITY_QUANTIZATION_SCALE), DELTA_VELOCITY_QUANTIZATION_SCALE);
+    }
+    state.colliderRelativeDimensions = objectData.colliderData.colliderRelativeDimensions;
+    state.speed = objectData.speed;
+    state.objectScale = objectData.objectScale;
+    state.actionTimer = objectData.actionTimer;
+    state.motionEnums = PackMotionEnums(objectData);
+    state.typeEnums = PackTypeEnums(objectData);
+    state.displayNameHash = GetDeltaStringHash(objectData.displayName, sizeof(objectData.displayName));
+    state.currentMapHash = GetDeltaStringHash(objectData.currentMap, sizeof(objectData.currentMap));
+    return state;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline uint32_t GetObjectDeltaChangeMask(const ObjectDeltaState& state, const ObjectDeltaState& baselineState)
+{
+    using namespace object_delta_fields;
+    
+    uint32_t changeMask = 0;
+    if (state.position[0] != baselineState.position[0] || state.position[1] != baselineState.position[1] || state.position[2] != baselineState.position[2]) changeMask |= POSITION;
+    if (state.velocity[0] != baselineState.velocity[0] || state.velocity[1] != baselineState.velocity[1] || state.velocity[2] != baselineState.velocity[2]) changeMask |= VELOCITY;
+    if (state.motionEnums != baselineState.motionEnums) changeMask |= FACING_AND_STATE;
+    if (state.actionTimer != baselineState.actionTimer) changeMask |= ACTION_TIMER;
+    if (state.currentHealthPoints != baselineState.currentHealthPoints) changeMask |= CURRENT_HEALTH;
+    if (state.speed != baselineState.speed || state.objectScale != baselineState.objectScale) changeMask |= SPEED_AND_SCALE;
+    if (state.typeEnums != baselineState.typeEnums) changeMask |= TYPE_ENUMS;
+    if (state.colliderRelativeDimensions != baselineState.colliderRelativeDimensions) changeMask |= COLLIDER_DIMENSIONS;
+    if (state.maxHealthPoints != baselineState.maxHealthPoints || state.damagePoints != baselineState.damagePoints) changeMask |= MAX_HEALTH_AND_DAMAGE;
+    if (state.parentObjectId != baselineState.parentObjectId) changeMask |= PARENT_OBJECT_ID;
+    if (state.displayNameHash != baselineState.displayNameHash) changeMask |= DISPLAY_NAME;
+    if (state.currentMapHash != baselineState.currentMapHash) changeMask |= CURRENT_MAP;
+    return changeMask;
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline int64_t GetWrappedHealthDelta(const health_t value, const health_t baseline)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(value) - static_cast<uint64_t>(baseline));
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline health_t ApplyWrappedHealthDelta(const health_t baseline, const int64_t delta)
+{
+    return static_cast<health_t>(static_cast<uint64_t>(baseline) + static_cast<uint64_t>(delta));
+}
+
+///------------------------------------------------------------------------------------------------
+/// Encodes objectData against baselineState. Returns false only if the payload did not
+/// fit, which can't happen with the current field set but is checked nevertheless.
+inline bool EncodeObjectDelta(const ObjectData& objectData, const ObjectDeltaState& state, const ObjectDeltaState& baselineState, const uint32_t sequence, const uint32_t baselineSequence, ObjectDeltaData& outDeltaData)
+{
+    using namespace object_delta_fields;
+    using namespace object_delta_enum_bits;
+    
+    outDeltaData.objectId = objectData.objectId;
+    outDeltaData.sequence = sequence;
+    outDeltaData.baselineSequence = baselineSequence;
+    
+    BitWriter writer(outDeltaData.payload, MAX_OBJECT_DELTA_PAYLOAD_SIZE);
+    
+    const auto changeMask = GetObjectDeltaChangeMask(state, baselineState);
+    writer.WriteVarUInt(changeMask);
+    
+    if (changeMask & POSITION)
+    {
+        for (int i = 0; i < 3; ++i) writer.WriteVarInt(static_cast<int64_t>(state.position[i]) - baselineState.position[i]);
+    }
+    if (changeMask & VELOCITY)
+    {
+        for (int i = 0; i < 3; ++i) writer.WriteVarInt(static_cast<int64_t>(state.velocity[i]) - baselineState.velocity[i]);
+    }
+    if (changeMask & FACING_AND_STATE)
+    {
+        writer.WriteBits(state.motionEnums, FACING_DIRECTION + OBJECT_STATE);
+    }
+    if (changeMask & TYPE_ENUMS)
+    {
+        writer.WriteBits(state.typeEnums, OBJECT_TYPE + ATTACK_TYPE + PROJECTILE_TYPE + OBJECT_FACTION + COLLIDER_TYPE);
+    }
+    if (changeMask & ACTION_TIMER)
+    {
+        writer.WriteFloat(state.actionTimer);
+    }
+    if (changeMask & CURRENT_HEALTH)
+    {
+        writer.WriteVarInt(GetWrappedHealthDelta(state.currentHealthPoints, baselineState.currentHealthPoints));
+    }
+    if (changeMask & SPEED_AND_SCALE)
+    {
+        writer.WriteFloat(state.speed);
+        writer.WriteFloat(state.objectScale);
+    }
+    if (changeMask & COLLIDER_DIMENSIONS)
+    {
+        writer.WriteFloat(state.colliderRelativeDimensions.x);
+        writer.WriteFloat(state.colliderRelativeDimensions.y);
+    }
+    if (changeMask & MAX_HEALTH_AND_DAMAGE)
+    {
+        writer.WriteVarInt(state.maxHealthPoints);
+        writer.WriteVarInt(state.damagePoints);
+    }
+    if (changeMask & PARENT_OBJECT_ID)
+    {
+        writer.WriteVarUInt(state.parentObjectId);
+    }
+    if (changeMask & DISPLAY_NAME)
+    {
+        writer.WriteString(objectData.displayName, sizeof(objectData.displayName) - 1);
+    }
+    if (changeMask & CURRENT_MAP)
+    {
+        writer.WriteString(objectData.currentMap, sizeof(objectData.currentMap) - 1);
+    }
+    
+    outDeltaData.payloadSize = static_cast<uint16_t>(writer.GetBytesWritten());
+    return !writer.HasOverflown();
+}
+
+///------------------------------------------------------------------------------------------------
+/// Reconstructs the full object from a delta and the baseline it was encoded against
+/// (a default constructed ObjectData for keyframes). Returns false on malformed payloads.
+inline bool DecodeObjectDelta(const ObjectDeltaData& deltaData, const ObjectData& baseline, ObjectData& outObjectData)
+{
+    using namespace object_delta_fields;
+    using namespace object_delta_enum_bits;
+    
+    if (deltaData.payloadSize > MAX_OBJECT_DELTA_PAYLOAD_SIZE)
+    {
+        return false;
+    }
+    
+    ObjectData result = baseline;
+    result.objectId = deltaData.objectId;
+    
+    BitReader reader(deltaData.payload, deltaData.payloadSize);
+    const auto changeMask = reader.ReadVarUInt();
+    
+    if (changeMask & POSITION)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto baselineValue = QuantizeDeltaValue(baseline.position[i], DELTA_POSITION_QUANTIZATION_SCALE);
+            result.position[i] = DequantizeDeltaValue(static_cast<int32_t>(baselineValue + reader.ReadVarInt()), DELTA_POSITION_QUANTIZATION_SCALE);
+        }
+    }
+    if (changeMask & VELOCITY)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const auto baselineValue = QuantizeDeltaValue(baseline.velocity[i], DELTA_VELOCITY_QUANTIZATION_SCALE);
+            result.velocity[i] = DequantizeDeltaValue(static_cast<int32_t>(baselineValue + reader.ReadVarInt()), DELTA_VELOCITY_QUANTIZATION_SCALE);
+        }
+    }
+    if (changeMask & FACING_AND_STATE)
+    {
+        UnpackMotionEnums(reader.ReadBits(FACING_DIRECTION + OBJECT_STATE), result);
+    }
+    if (changeMask & TYPE_ENUMS)
+    {
+        UnpackTypeEnums(reader.ReadBits(OBJECT_TYPE + ATTACK_TYPE + PROJECTILE_TYPE + OBJECT_FACTION + COLLIDER_TYPE), result);
+    }
+    if (changeMask & ACTION_TIMER)
+    {
+        result.actionTimer = reader.ReadFloat();
+    }
+    if (changeMask & CURRENT_HEALTH)
+    {
+        result.currentHealthPoints = ApplyWrappedHealthDelta(baseline.currentHealthPoints, reader.ReadVarInt());
+    }
+    if (changeMask & SPEED_AND_SCALE)
+    {
+        result.speed = reader.ReadFloat();
+        result.objectScale = reader.ReadFloat();
+    }
+    if (changeMask & COLLIDER_DIMENSIONS)
+    {
+        result.colliderData.colliderRelativeDimensions.x = reader.ReadFloat();
+        result.colliderData.colliderRelativeDimensions.y = reader.ReadFloat();
+    }
+    if (changeMask & MAX_HEALTH_AND_DAMAGE)
+    {
+        result.maxHealthPoints = reader.ReadVarInt();
+        result.damagePoints = reader.ReadVarInt();
+    }
+    if (changeMask & PARENT_OBJECT_ID)
+    {
+        result.parentObjectId = reader.ReadVarUInt();
+    }
+    if (changeMask & DISPLAY_NAME)
+    {
+        reader.ReadString(result.displayName, sizeof(result.displayName));
+    }
+    if (changeMask & CURRENT_MAP)
+    {
+        reader.ReadString(result.currentMap, sizeof(result.currentMap));
+    }
+    
+    if (reader.HasOverflown())
+    {
+        return false;
+    }
+    
+    outObjectData = result;
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Serial number comparison (RFC 1982), so that acks keep advancing after the sequences wrap.
+inline bool IsObjectDeltaSequenceNewer(const uint32_t sequence, const uint32_t otherSequence)
+{
+    return static_cast<int32_t>(sequence - otherSequence) > 0;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Increments a delta sequence, skipping NO_DELTA_BASELINE when it wraps.
+inline uint32_t GetNextObjectDeltaSequence(const uint32_t sequence)
+{
+    const auto nextSequence = sequence + 1;
+    return nextSequence == NO_DELTA_BASELINE ? nextSequence + 1 : nextSequence;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Server side, one per connected peer. Remembers the last OBJECT_DELTA_HISTORY_SIZE
+/// states sent for each object and encodes new states against the latest one the peer
+/// has acknowledged (via ObjectStateAckMessage), falling back to keyframes otherwise.
+/// Sequences are expected to increase monotonically per peer (e.g. the server tick), and may
+/// wrap. A state sent with sequence NO_DELTA_BASELINE is never used as a baseline, so
+/// sequences should be advanced with GetNextObjectDeltaSequence.
+class ObjectDeltaBaselineTracker
+{
+public:
+    inline bool EncodeObjectStateDelta(const ObjectData& objectData, const uint32_t sequence, ObjectDeltaData& outDeltaData)
+    {
+        static const ObjectDeltaState KEYFRAME_BASELINE_STATE = CreateObjectDeltaState(ObjectData());
+        
+        auto& history = mObjectHistories[objectData.objectId];
+        const auto state = CreateObjectDeltaState(objectData);
+        
+        // The peer only keeps the last OBJECT_DELTA_HISTORY_SIZE states around, so an older
+        // ack can't be used as a baseline anymore.
+        const auto hasUsableBaseline = history.mAckedSequence != NO_DELTA_BASELINE && sequence - history.mAckedSequence < OBJECT_DELTA_HISTORY_SIZE;
+        const auto result = hasUsableBaseline ?
+            EncodeObjectDelta(objectData, state, history.mAckedState, sequence, history.mAckedSequence, outDeltaData) :
+            EncodeObjectDelta(objectData, state, KEYFRAME_BASELINE_STATE, sequence, NO_DELTA_BASELINE, outDeltaData);
+        
+        if (sequence != NO_DELTA_BASELINE)
+        {
+            auto& sentState = history.mSentStates[sequence % OBJECT_DELTA_HISTORY_SIZE];
+            sentState.mSequence = sequence;
+            sentState.mState = state;
+        }
+        
+        return result;
+    }
+    
+    inline void AcknowledgeObjectState(const objectId_t objectId, const uint32_t sequence)
+    {
+        auto historyIter = mObjectHistories.find(objectId);
+        if (historyIter == mObjectHistories.end() || sequence == NO_DELTA_BASELINE)
+        {
+            return;
+        }
+        
+        auto& history = historyIter->second;
+        const auto& sentState = history.mSentStates[sequence % OBJECT_DELTA_HISTORY_SIZE];
+        if (sentState.mSequence == sequence && (history.mAckedSequence == NO_DELTA_BASELINE || IsObjectDeltaSequenceNewer(sequence, history.mAckedSequence)))
+        {
+            history.mAckedSequence = sequence;
+            history.mAckedState = sentState.mState;
+        }
+    }
+    
+    inline void RemoveObject(const objectId_t objectId)
+    {
+        mObjectHistories.erase(objectId);
+    }
+    
+    inline void Clear()
+    {
+        mObjectHistories.clear();
+    }
+
+private:
+    struct SentObjectState
+    {
+        uint32_t mSequence = NO_DELTA_BASELINE;
+        ObjectDeltaState mState;
+    };
+    
+    struct ObjectBaselineHistory
+    {
+        SentObjectState mSentStates[OBJECT_DELTA_HISTORY_SIZE];
+        ObjectDeltaState mAckedState;
+        uint32_t mAckedSequence = NO_DELTA_BASELINE;
+    };
+    
+    std::unordered_map<objectId_t, ObjectBaselineHistory> mObjectHistories;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Client side counterpart of the ObjectDeltaBaselineTracker. Keeps the last
+/// OBJECT_DELTA_HISTORY_SIZE decoded states per object so that deltas against any
+/// acknowledged baseline can be applied. After a successful apply the caller should
+/// ack (objectId, sequence) back to the server; acking every update is not required.
+class ObjectDeltaReceiver
+{
+public:
+    inline bool ApplyObjectStateDelta(const ObjectDeltaData& deltaData, ObjectData& outObjectData)
+    {
+        auto& history = mObjectHistories[deltaData.objectId];
+        
+        bool result = false;
+        if (deltaData.baselineSequence == NO_DELTA_BASELINE)
+        {
+            result = DecodeObjectDelta(deltaData, ObjectData(), outObjectData);
+        }
+        else
+        {
+            const auto& baseline = history.mReceivedStates[deltaData.baselineSequence % OBJECT_DELTA_HISTORY_SIZE];
+            if (baseline.mSequence != deltaData.baselineSequence)
+            {
+                return false;
+            }
+            
+            result = DecodeObjectDelta(deltaData, baseline.mObjectData, outObjectData);
+        }
+        
+        if (result)
+        {
+            auto& receivedState = history.mReceivedStates[deltaData.sequence % OBJECT_DELTA_HISTORY_SIZE];
+            receivedState.mSequence = deltaData.sequence;
+            receivedState.mObjectData = outObjectData;
+        }
+        
+        return result;
+    }
+    
+    inline void RemoveObject(const objectId_t objectId)
+    {
+        mObjectHistories.erase(objectId);
+    }
+    
+    inline void Clear()
+    {
+        mObjectHistories.clear();
+    }
+
+private:
+    struct ReceivedObjectState
+    {
+        uint32_t mSequence = NO_DELTA_BASELINE;
+        ObjectData mObjectData;
+    };
+    
+    struct ObjectReceivedHistory
+    {
+        ReceivedObjectState mReceivedStates[OBJECT_DELTA_HISTORY_SIZE];
+    };
+    
+    std::unordered_map<objectId_t, ObjectReceivedHistory> mObjectHistories;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // OBJECT_DATA_DELTA_H
@@ -0,0 +1,354 @@
+///------------------------------------------------------------------------------------------------
+///  ObjectTable.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef OBJECT_TABLE_H
+#define OBJECT_TABLE_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkCommon.h>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline constexpr uint32_t INVALID_OBJECT_SLOT = static_cast<uint32_t>(-1);
+inline constexpr size_t NO_OBJECT_TABLE_INDEX = static_cast<size_t>(-1);
+
+///------------------------------------------------------------------------------------------------
+/// Stable reference to an object of an ObjectTable. Unlike object indices, handles survive the
+/// removal of other objects, and the handle of a removed object never becomes valid again.
+struct ObjectHandle
+{
+    uint32_t mSlot = INVALID_OBJECT_SLOT;
+    uint32_t mGeneration = 0;
+    
+    inline bool IsNull() const { return mSlot == INVALID_OBJECT_SLOT; }
+    inline bool operator == (const ObjectHandle& other) const { return mSlot == other.mSlot && mGeneration == other.mGeneration; }
+    inline bool operator != (const ObjectHandle& other) const { return !(*this == other); }
+};
+
+///------------------------------------------------------------------------------------------------
+/// The fields of an ObjectData that are rarely touched per tick. Same names as in ObjectData.
+struct ObjectColdData
+{
+    objectId_t parentObjectId;
+    ObjectType objectType;
+    AttackType attackType;
+    ProjectileType projectileType;
+    FacingDirection facingDirection;
+    ObjectFaction objectFaction;
+    health_t maxHealthPoints;
+    health_t currentHealthPoints;
+    health_t damagePoints;
+    float speed;
+    char displayName[64] = {};
+    char currentMap[64] = {};
+};
+
+///------------------------------------------------------------------------------------------------
+/// What collision checks need of an object, gathered from the hot columns of an ObjectTable.
+/// Has the same member names as ObjectData, so it can be passed to collision::CollidersIntersect & co.
+struct ObjectColliderView
+{
+    objectId_t objectId;
+    glm::vec3 position;
+    ObjectColliderData colliderData;
+    float objectScale;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Server side object storage, as an alternative to std::vector<ObjectData>. The per tick
+/// fields live in separate, densely packed columns (structure of arrays) so that loops over
+/// e.g. positions only pull positions through the cache, while everything else lives in a
+/// cold side table indexed the same way.
+///
+///     auto& positions = objectTable.GetPositions();
+///     const auto& velocities = objectTable.GetVelocities();
+///     for (size_t i = 0; i < objectTable.GetObjectCount(); ++i) positions[i] += velocities[i] * dt;
+///
+/// Object indices are in [0, GetObjectCount()) and are only valid until the next RemoveObject,
+/// which swap-removes (i.e. moves the last object into the freed index). ObjectHandles stay
+/// valid for as long as their object is in the table. Wire messages are filled through
+/// ReadObjectData (e.g. straight into ObjectStateUpdateMessage::objectData).
+class ObjectTable final
+{
+public:
+    inline size_t GetObjectCount() const { return mObjectIds.size(); }
+    
+    inline void Reserve(const size_t objectCount)
+    {
+        mObjectIds.reserve(objectCount);
+        mPositions.reserve(objectCount);
+        mVelocities.reserve(objectCount);
+        mObjectStates.reserve(objectCount);
+        mActionTimers.reserve(objectCount);
+        mColliderData.reserve(objectCount);
+        mObjectScales.reserve(objectCount);
+        mColdData.reserve(objectCount);
+        mObjectSlots.reserve(objectCount);
+        mObjectIdSlots.reserve(objectCount);
+    }
+    
+    inline void Clear()
+    {
+        // Existing handles must not become valid again, so every used slot is freed rather than dropped
+        for (const auto slot: mObjectSlots)
+        {
+            mSlots[slot].mObjectIndex = INVALID_OBJECT_SLOT;
+            mSlots[slot].mGeneration++;
+            mFreeSlots.push_back(slot);
+        }
+        
+        mObjectIds.clear();
+        mPositions.clear();
+        mVelocities.clear();
+        mObjectStates.clear();
+        mActionTimers.clear();
+        mColliderData.clear();
+        mObjectScales.clear();
+        mColdData.clear();
+        mObjectSlots.clear();
+        mObjectIdSlots.clear();
+    }
+    
+    /// Returns a null handle if the object id is already in the table.
+    inline ObjectHandle AddObject(const ObjectData& objectData)
+    {
+        if (mObjectIdSlots.count(objectData.objectId) != 0)
+        {
+            return ObjectHandle();
+        }
+        
+        uint32_t slot = INVALID_OBJECT_SLOT;
+        if (!mFreeSlots.empty())
+        {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back(ObjectSlot());
+        }
+        
+        const auto objectIndex = mObjectIds.size();
+        mSlots[slot].mObjectIndex = static_cast<uint32_t>(objectIndex);
+        mObjectIdSlots[objectData.objectId] = slot;
+        mObjectSlots.push_back(slot);
+        
+        mObjectIds.push_back(objectData.objectId);
+        mPositions.push_back(objectData.position);
+        mVelocities.push_back(objectData.velocity);
+        mObjectStates.push_back(objectData.objectState);
+        mActionTimers.push_back(objectData.actionTimer);
+        mColliderData.push_back(objectData.colliderData);
+        mObjectScales.push_back(objectData.objectScale);
+        mColdData.emplace_back();
+        WriteColdData(objectData, mColdData.back());
+        
+        return ObjectHandle{ slot, mSlots[slot].mGeneration };
+    }
+    
+    /// Swap-removes the object, optionally copying it out first. Returns false for stale handles.
+    inline bool RemoveObject(const ObjectHandle objectHandle, ObjectData* outObjectData = nullptr)
+    {
+        const auto objectIndex = GetObjectIndex(objectHandle);
+        if (objectIndex == NO_OBJECT_TABLE_INDEX)
+        {
+            return false;
+        }
+        
+        if (outObjectData)
+        {
+            ReadObjectData(objectIndex, *outObjectData);
+        }
+        
+        mObjectIdSlots.erase(mObjectIds[objectIndex]);
+        mSlots[objectHandle.mSlot].mObjectIndex = INVALID_OBJECT_SLOT;
+        mSlots[objectHandle.mSlot].mGeneration++;
+        mFreeSlots.push_back(objectHandle.mSlot);
+        
+        const auto lastObjectIndex = mObjectIds.size() - 1;
+        if (objectIndex != lastObjectIndex)
+        {
+            mObjectIds[objectIndex] = mObjectIds[lastObjectIndex];
+            mPositions[objectIndex] = mPositions[lastObjectIndex];
+            mVelocities[objectIndex] = mVelocities[lastObjectIndex];
+            mObjectStates[objectIndex] = mObjectStates[lastObjectIndex];
+            mActionTimers[objectIndex] = mActionTimers[lastObjectIndex];
+            mColliderData[objectIndex] = mColliderData[lastObjectIndex];
+            mObjectScales[objectIndex] = mObjectScales[lastObjectIndex];
+            mColdData[objectIndex] = mColdData[lastObjectIndex];
+            mObjectSlots[objectIndex] = mObjectSlots[lastObjectIndex];
+            mSlots[mObjectSlots[objectIndex]].mObjectIndex = static_cast<uint32_t>(objectIndex);
+        }
+        
+        mObjectIds.pop_back();
+        mPositions.pop_back();
+        mVelocities.pop_back();
+        mObjectStates.pop_back();
+        mActionTimers.pop_back();
+        mColliderData.pop_back();
+        mObjectScales.pop_back();
+        mColdData.pop_back();
+        mObjectSlots.pop_back();
+        return true;
+    }
+    
+    inline bool RemoveObject(const objectId_t objectId, ObjectData* outObjectData = nullptr)
+    {
+        return RemoveObject(FindObject(objectId), outObjectData);
+    }
+    
+    /// Returns a null handle for unknown object ids.
+    inline ObjectHandle FindObject(const objectId_t objectId) const
+    {
+        auto slotIter = mObjectIdSlots.find(objectId);
+        return slotIter == mObjectIdSlots.end() ? ObjectHandle() : ObjectHandle{ slotIter->second, mSlots[slotIter->second].mGeneration };
+    }
+    
+    inline bool IsValid(const ObjectHandle objectHandle) const
+    {
+        return objectHandle.mSlot < mSlots.size() && mSlots[objectHandle.mSlot].mGeneration == objectHandle.mGeneration && mSlots[objectHandle.mSlot].mObjectIndex != INVALID_OBJECT_SLOT;
+    }
+    
+    /// Returns NO_OBJECT_TABLE_INDEX for stale handles.
+    inline size_t GetObjectIndex(const ObjectHandle objectHandle) const
+    {
+        return IsValid(objectHandle) ? static_cast<size_t>(mSlots[objectHandle.mSlot].mObjectIndex) : NO_OBJECT_TABLE_INDEX;
+    }
+    
+    inline ObjectHandle GetObjectHandle(const size_t objectIndex) const
+    {
+        const auto slot = mObjectSlots[objectIndex];
+        return ObjectHandle{ slot, mSlots[slot].mGeneration };
+    }
+    
+    // Hot columns, indexed by object index. Their sizes must not be changed from the outside.
+    inline const std::vector<objectId_t>& GetObjectIds() const { return mObjectIds; }
+    inline std::vector<glm::vec3>& GetPositions() { return mPositions; }
+    inline const std::vector<glm::vec3>& GetPositions() const { return mPositions; }
+    inline std::vector<glm::vec3>& GetVelocities() { return mVelocities; }
+    inline const std::vector<glm::vec3>& GetVelocities() const { return mVelocities; }
+    inline std::vector<ObjectState>& GetObjectStates() { return mObjectStates; }
+    inline const std::vector<ObjectState>& GetObjectStates() const { return mObjectStates; }
+    inline std::vector<float>& GetActionTimers() { return mActionTimers; }
+    inline const std::vector<float>& GetActionTimers() const { return mActionTimers; }
+    inline std::vector<ObjectColliderData>& GetColliderData() { return mColliderData; }
+    inline const std::vector<ObjectColliderData>& GetColliderData() const { return mColliderData; }
+    inline std::vector<float>& GetObjectScales() { return mObjectScales; }
+    inline const std::vector<float>& GetObjectScales() const { return mObjectScales; }
+    
+    inline ObjectColdData& GetColdData(const size_t objectIndex) { return mColdData[objectIndex]; }
+    inline const ObjectColdData& GetColdData(const size_t objectIndex) const { return mColdData[objectIndex]; }
+    
+    inline ObjectColliderView GetColliderView(const size_t objectIndex) const
+    {
+        return ObjectColliderView{ mObjectIds[objectIndex], mPositions[objectIndex], mColliderData[objectIndex], mObjectScales[objectIndex] };
+    }
+    
+    inline glm::vec3 GetColliderDimensions(const size_t objectIndex) const
+    {
+        return glm::vec3(mColliderData[objectIndex].colliderRelativeDimensions.x * mObjectScales[objectIndex], mColliderData[objectIndex].colliderRelativeDimensions.y * mObjectScales[objectIndex], 1.0f);
+    }
+    
+    /// Gathers the object back into an ObjectData, e.g. for wire messages.
+    inline void ReadObjectData(const size_t objectIndex, ObjectData& outObjectData) const
+    {
+        const auto& coldData = mColdData[objectIndex];
+        outObjectData.objectId = mObjectIds[objectIndex];
+        outObjectData.parentObjectId = coldData.parentObjectId;
+        outObjectData.objectType = coldData.objectType;
+        outObjectData.attackType = coldData.attackType;
+        outObjectData.projectileType = coldData.projectileType;
+        outObjectData.facingDirection = coldData.facingDirection;
+        outObjectData.objectState = mObjectStates[objectIndex];
+        outObjectData.colliderData = mColliderData[objectIndex];
+        outObjectData.objectFaction = coldData.objectFaction;
+        outObjectData.position = mPositions[objectIndex];
+        outObjectData.velocity = mVelocities[objectIndex];
+        outObjectData.maxHealthPoints = coldData.maxHealthPoints;
+        outObjectData.currentHealthPoints = coldData.currentHealthPoints;
+        outObjectData.damagePoints = coldData.damagePoints;
+        outObjectData.speed = coldData.speed;
+        outObjectData.objectScale = mObjectScales[objectIndex];
+        outObjectData.actionTimer = mActionTimers[objectIndex];
+        std::memcpy(outObjectData.displayName, coldData.displayName, sizeof(outObjectData.displayName));
+        std::memcpy(outObjectData.currentMap, coldData.currentMap, sizeof(outObjectData.currentMap));
+    }
+    
+    /// Scatters an ObjectData (e.g. from the wire) over the object. Its objectId is ignored, as
+    /// objects can't change ids while in the table.
+    inline void WriteObjectData(const size_t objectIndex, const ObjectData& objectData)
+    {
+        mPositions[objectIndex] = objectData.position;
+        mVelocities[objectIndex] = objectData.velocity;
+        mObjectStates[objectIndex] = objectData.objectState;
+        mActionTimers[objectIndex] = objectData.actionTimer;
+        mColliderData[objectIndex] = objectData.colliderData;
+        mObjectScales[objectIndex] = objectData.objectScale;
+        WriteColdData(objectData, mColdData[objectIndex]);
+    }
+
+private:
+    struct ObjectSlot
+    {
+        uint32_t mObjectIndex = INVALID_OBJECT_SLOT;
+        uint32_t mGeneration = 0;
+    };
+    
+    static inline void WriteColdData(const ObjectData& objectData, ObjectColdData& outColdData)
+    {
+        outColdData.parentObjectId = objectData.parentObjectId;
+        outColdData.objectType = objectData.objectType;
+        outColdData.attackType = objectData.attackType;
+        outColdData.projectileType = objectData.projectileType;
+        outColdData.facingDirection = objectData.facingDirection;
+        outColdData.objectFaction = objectData.objectFaction;
+        outColdData.maxHealthPoints = objectData.maxHealthPoints;
+        outColdData.currentHealthPoints = objectData.currentHealthPoints;
+        outColdData.damagePoints = objectData.damagePoints;
+        outColdData.speed = objectData.speed;
+        std::memcpy(outColdData.displayName, objectData.displayName, sizeof(outColdData.displayName));
+        std::memcpy(outColdData.currentMap, objectData.currentMap, sizeof(outColdData.currentMap));
+    }
+
+private:
+    // Hot columns
+    std::vector<objectId_t> mObjectIds;
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::vec3> mVelocities;
+    std::vector<ObjectState> mObjectStates;
+    std::vector<float> mActionTimers;
+    std::vector<ObjectColliderData> mColliderData;
+    std::vector<float> mObjectScales;
+    
+    // Cold side table
+    std::vector<ObjectColdData> mColdData;
+    
+    // Handle bookkeeping
+    std::vector<uint32_t> mObjectSlots; // Indexed by object index
+    std::vector<ObjectSlot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+    std::unordered_map<objectId_t, uint32_t> mObjectIdSlots;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // OBJECT_TABLE_H
@@ -0,0 +1,285 @@
+///------------------------------------------------------------------------------------------------
+///  PackedNavmap.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef PackedNavmap_h
+#define PackedNavmap_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/Navmap.h>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline int PopCount64(const uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(value));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    auto remaining = value;
+    int count = 0;
+    for (; remaining != 0; ++count)
+    {
+        remaining &= remaining - 1;
+    }
+    return count;
+#endif
+}
+
+///------------------------------------------------------------------------------------------------
+/// Owning navmap, decoded once from the RGBA pixels (or from an existing Navmap).
+/// Tiles are stored as one row bitmask per non walkable tile type (SOLID and WATER), 64 tiles
+/// per word, i.e. 2 bits per tile in planar form and 16x smaller than the RGBA pixels.
+/// A tile lookup is a couple of shift-and-masks, and region queries test/count a whole
+/// row word at a time.
+///
+/// Same coordinate conventions as the Navmap (positive right and positive down). Regions
+/// are given as inclusive [minCoord, maxCoord] navmap coords.
+///
+/// Can also be a non owning view over row masks decoded ahead of time (e.g. the mmap-ed ones of
+/// CookedWorldAssets), in which case the masks need to outlive it.
+class PackedNavmap
+{
+public:
+    PackedNavmap(const unsigned char* navmapPixels, const int navmapSize)
+    : mNavmapSize(navmapSize)
+    , mWordsPerRow((navmapSize + 63) / 64)
+    , mIsView(false)
+    {
+        Navmap navmap(navmapPixels, navmapSize);
+        Decode(navmap);
+    }
+    
+    explicit PackedNavmap(const Navmap& navmap)
+    : mNavmapSize(navmap.GetSize())
+    , mWordsPerRow((navmap.GetSize() + 63) / 64)
+    , mIsView(false)
+    {
+        Decode(navmap);
+    }
+    
+    /// Non owning view. Both mask arrays hold GetRowMaskWordCount() words, laid out as the ones
+    /// of GetSolidRowMasks and GetWaterRowMasks.
+    PackedNavmap(const uint64_t* solidRowMasks, const uint64_t* waterRowMasks, const int navmapSize)
+    : mNavmapSize(navmapSize)
+    , mWordsPerRow((navmapSize + 63) / 64)
+    , mIsView(true)
+    , mSolidRowMasks(solidRowMasks)
+    , mWaterRowMasks(waterRowMasks)
+    {
+    }
+    
+    PackedNavmap(const PackedNavmap& other)
+    : mNavmapSize(other.mNavmapSize)
+    , mWordsPerRow(other.mWordsPerRow)
+    , mIsView(other.mIsView)
+    , mOwnedSolidRowMasks(other.mOwnedSolidRowMasks)
+    , mOwnedWaterRowMasks(other.mOwnedWaterRowMasks)
+    , mSolidRowMasks(mIsView ? other.mSolidRowMasks : mOwnedSolidRowMasks.data())
+    , mWaterRowMasks(mIsView ? other.mWaterRowMasks : mOwnedWaterRowMasks.data())
+    {
+    }
+    
+    PackedNavmap& operator = (const PackedNavmap&) = delete;
+    
+    inline glm::vec3 GetMapPositionFromNavmapCoord(const glm::ivec2& navmapCoord, const glm::vec2& mapPosition, const float mapScale, const float positionZ) const
+    {
+        const float invSize = 1.0f/mNavmapSize;
+        return glm::vec3(mapScale * ((navmapCoord.x + 0.5f) * invSize - 0.5f) + (mapPosition.x * mapScale),
+                         mapScale * (0.5f - (navmapCoord.y + 0.5f) * invSize) + (mapPosition.y * mapScale),
+                         positionZ);
+    }
+    
+    inline glm::ivec2 GetNavmapCoord(const glm::vec3& objectPosition, const glm::vec2& mapPosition, const float mapScale) const
+    {
+        return glm::ivec2(static_cast<int>(((objectPosition.x - (mapPosition.x * mapScale))/mapScale + 0.5f) * mNavmapSize),
+                          static_cast<int>((1.0f - ((objectPosition.y - (mapPosition.y * mapScale))/mapScale + 0.5f)) * mNavmapSize));
+    }
+    
+    inline NavmapTileType GetNavmapTileAt(const glm::ivec2& navmapCoord) const
+    {
+        const auto wordIndex = navmapCoord.y * mWordsPerRow + (navmapCoord.x >> 6);
+        const auto bit = uint64_t(1) << (navmapCoord.x & 63);
+        
+        if (mSolidRowMasks[wordIndex] & bit)
+        {
+            return NavmapTileType::SOLID;
+        }
+        
+        return (mWaterRowMasks[wordIndex] & bit) ? NavmapTileType::WATER : NavmapTileType::WALKABLE;
+    }
+    
+    inline bool IsNavmapCoordInBounds(const glm::ivec2& navmapCoord) const
+    {
+        return navmapCoord.x >= 0 && navmapCoord.y >= 0 && navmapCoord.x < mNavmapSize && navmapCoord.y < mNavmapSize;
+    }
+    
+    /// Row bitmask of the tiles of the given type in [64 * wordIndex, 64 * wordIndex + 63] of the row.
+    inline uint64_t GetTileTypeRowMask(const NavmapTileType tileType, const int row, const int wordIndex) const
+    {
+        const auto index = row * mWordsPerRow + wordIndex;
+        switch (tileType)
+        {
+            case NavmapTileType::SOLID: return mSolidRowMasks[index];
+            case NavmapTileType::WATER: return mWaterRowMasks[index];
+            case NavmapTileType::WALKABLE: return ~(mSolidRowMasks[index] | mWaterRowMasks[index]) & GetValidTilesMask(wordIndex);
+            default: break;
+        }
+        
+        return 0;
+    }
+    
+    /// True if every tile of the region is of the given type. Regions reaching outside the navmap never are.
+    inline bool IsRegionOfType(const glm::ivec2& minCoord, const glm::ivec2& maxCoord, const NavmapTileType tileType) const
+    {
+        if (!IsNavmapCoordInBounds(minCoord) || !IsNavmapCoordInBounds(maxCoord))
+        {
+            return false;
+        }
+        
+        bool allOfType = true;
+        ForEachRegionWord(minCoord, maxCoord, [&](const int row, const int wordIndex, const uint64_t regionMask)
+        {
+            allOfType = allOfType && (GetTileTypeRowMask(tileType, row, wordIndex) & regionMask) == regionMask;
+            return allOfType;
+        });
+        return allOfType;
+    }
+    
+    inline bool IsRegionWalkable(const glm::ivec2& minCoord, const glm::ivec2& maxCoord) const
+    {
+        return IsRegionOfType(minCoord, maxCoord, NavmapTileType::WALKABLE);
+    }
+    
+    /// Counts the tiles of the given type in the part of the region that lies inside the navmap.
+    inline int CountTilesInRegion(const glm::ivec2& minCoord, const glm::ivec2& maxCoord, const NavmapTileType tileType) const
+    {
+        int tileCount = 0;
+        ForEachRegionWord(minCoord, maxCoord, [&](const int row, const int wordIndex, const uint64_t regionMask)
+        {
+            tileCount += PopCount64(GetTileTypeRowMask(tileType, row, wordIndex) & regionMask);
+            return true;
+        });
+        return tileCount;
+    }
+    
+    inline bool RegionContainsTileType(const glm::ivec2& minCoord, const glm::ivec2& maxCoord, const NavmapTileType tileType) const
+    {
+        bool containsType = false;
+        ForEachRegionWord(minCoord, maxCoord, [&](const int row, const int wordIndex, const uint64_t regionMask)
+        {
+            containsType = (GetTileTypeRowMask(tileType, row, wordIndex) & regionMask) != 0;
+            return !containsType;
+        });
+        return containsType;
+    }
+    
+    /// World space variant of IsRegionWalkable for an axis aligned box (e.g. an object's collider).
+    inline bool IsAreaWalkable(const glm::vec3& position, const glm::vec3& dimensions, const glm::vec2& mapPosition, const float mapScale) const
+    {
+        const auto topLeftCoord = GetNavmapCoord(glm::vec3(position.x - dimensions.x * 0.5f, position.y + dimensions.y * 0.5f, position.z), mapPosition, mapScale);
+        const auto botRightCoord = GetNavmapCoord(glm::vec3(position.x + dimensions.x * 0.5f, position.y - dimensions.y * 0.5f, position.z), mapPosition, mapScale);
+        return IsRegionWalkable(topLeftCoord, botRightCoord);
+    }
+    
+    inline int GetSize() const { return mNavmapSize; }
+    inline size_t GetMemoryUsageBytes() const { return (mOwnedSolidRowMasks.size() + mOwnedWaterRowMasks.size()) * sizeof(uint64_t); }
+    inline bool IsView() const { return mIsView; }
+    
+    /// Rows top to bottom, each being GetRowMaskWordCount() / GetSize() words with bit (x & 63)
+    /// of word (x >> 6) set for the tiles of the type.
+    inline const uint64_t* GetSolidRowMasks() const { return mSolidRowMasks; }
+    inline const uint64_t* GetWaterRowMasks() const { return mWaterRowMasks; }
+    inline size_t GetRowMaskWordCount() const { return static_cast<size_t>(mWordsPerRow) * mNavmapSize; }
+
+private:
+    inline void Decode(const Navmap& navmap)
+    {
+        mOwnedSolidRowMasks.assign(GetRowMaskWordCount(), 0);
+        mOwnedWaterRowMasks.assign(GetRowMaskWordCount(), 0);
+        mSolidRowMasks = mOwnedSolidRowMasks.data();
+        mWaterRowMasks = mOwnedWaterRowMasks.data();
+        
+        for (int y = 0; y < mNavmapSize; ++y)
+        {
+            for (int x = 0; x < mNavmapSize; ++x)
+            {
+                const auto wordIndex = y * mWordsPerRow + (x >> 6);
+                const auto bit = uint64_t(1) << (x & 63);
+                
+                switch (navmap.GetNavmapTileAt(glm::ivec2(x, y)))
+                {
+                    case NavmapTileType::SOLID: mOwnedSolidRowMasks[wordIndex] |= bit; break;
+                    case NavmapTileType::WATER: mOwnedWaterRowMasks[wordIndex] |= bit; break;
+                    default: break;
+                }
+            }
+        }
+    }
+    
+    /// Bits of the given row word that map onto actual tiles (the last word of a row may be partial).
+    inline uint64_t GetValidTilesMask(const int wordIndex) const
+    {
+        const auto tilesInWord = mNavmapSize - wordIndex * 64;
+        return tilesInWord >= 64 ? ~uint64_t(0) : (uint64_t(1) << tilesInWord) - 1;
+    }
+    
+    /// Calls visitor(row, wordIndex, regionMask) for every row word the region touches inside
+    /// the navmap, until it returns false.
+    template<typename VisitorT>
+    inline void ForEachRegionWord(const glm::ivec2& minCoord, const glm::ivec2& maxCoord, VisitorT&& visitor) const
+    {
+        const auto minX = math::Max(0, math::Min(minCoord.x, maxCoord.x));
+        const auto maxX = math::Min(mNavmapSize - 1, math::Max(minCoord.x, maxCoord.x));
+        const auto minY = math::Max(0, math::Min(minCoord.y, maxCoord.y));
+        const auto maxY = math::Min(mNavmapSize - 1, math::Max(minCoord.y, maxCoord.y));
+        
+        for (int row = minY; row <= maxY; ++row)
+        {
+            for (int wordIndex = minX >> 6; wordIndex <= (maxX >> 6); ++wordIndex)
+            {
+                const auto firstBit = math::Max(minX - wordIndex * 64, 0);
+                const auto lastBit = math::Min(maxX - wordIndex * 64, 63);
+                const auto regionMask = (lastBit == 63 ? ~uint64_t(0) : (uint64_t(1) << (lastBit + 1)) - 1) & ~((uint64_t(1) << firstBit) - 1);
+                
+                if (!visitor(row, wordIndex, regionMask))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    const int mNavmapSize;
+    const int mWordsPerRow;
+    const bool mIsView; // Tracked explicitly, as the owned masks of a size 0 navmap are empty too
+    std::vector<uint64_t> mOwnedSolidRowMasks; // Empty for views
+    std::vector<uint64_t> mOwnedWaterRowMasks;
+    const uint64_t* mSolidRowMasks = nullptr;
+    const uint64_t* mWaterRowMasks = nullptr;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* PackedNavmap_h */
@@ -0,0 +1,173 @@
+///------------------------------------------------------------------------------------------------
+///  PacketBufferPool.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef PACKET_BUFFER_POOL_H
+#define PACKET_BUFFER_POOL_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkMessages.h>
+#include <memory>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline constexpr size_t DEFAULT_PACKET_BUFFER_CAPACITY = 1200;
+
+///------------------------------------------------------------------------------------------------
+/// Recycles the payload buffers of outgoing packets. Packets are created with
+/// ENET_PACKET_FLAG_NO_ALLOCATE on top of a pooled buffer, and ENet hands the buffer back
+/// through the packet's free callback once every peer is done with it (i.e. right after it went
+/// out for unreliable packets, or once acknowledged for reliable ones). In steady state a tick's
+/// sends then reuse the buffers released by the previous ticks instead of hitting the allocator.
+///
+/// Not thread safe: create packets on the same thread that services the ENet host. Buffers
+/// still owned by ENet when the pool is destroyed are freed by ENet's callback on their own.
+class PacketBufferPool final
+{
+public:
+    PacketBufferPool(const size_t defaultBufferCapacity = DEFAULT_PACKET_BUFFER_CAPACITY)
+    : mDefaultBufferCapacity(defaultBufferCapacity)
+    {
+    }
+    
+    ~PacketBufferPool()
+    {
+        // Ownership of these goes to the free callback
+        for (auto* buffer: mBuffersInFlight)
+        {
+            buffer->mPool = nullptr;
+        }
+    }
+    
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator = (const PacketBufferPool&) = delete;
+    
+    /// Drop in replacement for enet_packet_create, for packets that go to enet_peer_send,
+    /// enet_host_broadcast or MulticastPacket.
+    inline ENetPacket* CreatePacket(const void* data, const size_t dataSize, const enet_uint32 flags)
+    {
+        auto* buffer = AcquireBuffer(dataSize);
+        std::memcpy(buffer->mData.data(), data, dataSize);
+        
+        ENetPacket* enetPacket = enet_packet_create(buffer->mData.data(), dataSize, flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+        if (enetPacket == nullptr)
+        {
+            ReleaseBuffer(buffer);
+            return nullptr;
+        }
+        
+        enetPacket->userData = buffer;
+        enetPacket->freeCallback = &PacketBufferPool::OnPacketFreed;
+        return enetPacket;
+    }
+    
+    /// Frees pooled buffers beyond maxFreeBuffers, e.g. after a spike in traffic.
+    inline void TrimFreeBuffers(const size_t maxFreeBuffers)
+    {
+        if (mFreeBuffers.size() > maxFreeBuffers)
+        {
+            mFreeBuffers.resize(maxFreeBuffers);
+        }
+    }
+    
+    inline size_t GetFreeBufferCount() const { return mFreeBuffers.size(); }
+    inline size_t GetBuffersInFlightCount() const { return mBuffersInFlight.size(); }
+
+private:
+    struct PacketBuffer
+    {
+        PacketBufferPool* mPool = nullptr;
+        std::vector<unsigned char> mData;
+        size_t mInFlightIndex = 0;
+    };
+    
+    inline PacketBuffer* AcquireBuffer(const size_t dataSize)
+    {
+        std::unique_ptr<PacketBuffer> buffer;
+        if (mFreeBuffers.empty())
+        {
+            buffer = std::make_unique<PacketBuffer>();
+            buffer->mPool = this;
+            buffer->mData.reserve(mDefaultBufferCapacity);
+        }
+        else
+        {
+            buffer = std::move(mFreeBuffers.back());
+            mFreeBuffers.pop_back();
+        }
+        
+        // Only grows on the rare oversized message, after which the buffer keeps its capacity
+        buffer->mData.resize(dataSize);
+        buffer->mInFlightIndex = mBuffersInFlight.size();
+        mBuffersInFlight.push_back(buffer.get());
+        return buffer.release();
+    }
+    
+    inline void ReleaseBuffer(PacketBuffer* buffer)
+    {
+        auto* lastBufferInFlight = mBuffersInFlight.back();
+        lastBufferInFlight->mInFlightIndex = buffer->mInFlightIndex;
+        mBuffersInFlight[buffer->mInFlightIndex] = lastBufferInFlight;
+        mBuffersInFlight.pop_back();
+        
+        mFreeBuffers.emplace_back(buffer);
+    }
+    
+    static void OnPacketFreed(ENetPacket* enetPacket)
+    {
+        auto* buffer = static_cast<PacketBuffer*>(enetPacket->userData);
+        if (buffer->mPool == nullptr)
+        {
+            delete buffer;
+            return;
+        }
+        
+        buffer->mPool->ReleaseBuffer(buffer);
+    }
+
+private:
+    const size_t mDefaultBufferCapacity;
+    std::vector<std::unique_ptr<PacketBuffer>> mFreeBuffers;
+    std::vector<PacketBuffer*> mBuffersInFlight; // Owned by ENet until their packet is freed
+};
+
+///------------------------------------------------------------------------------------------------
+/// Same as MulticastMessage, with the packet payload coming out of the pool.
+inline void MulticastMessage(ENetPeer* const* toPeers, const size_t peerCount, const void* message, const size_t messageSize, const enet_uint32 channel, PacketBufferPool& packetBufferPool)
+{
+    if (peerCount == 0)
+    {
+        return;
+    }
+    
+    ENetPacket* enetPacket = packetBufferPool.CreatePacket(message, messageSize, channel);
+    if (enetPacket != nullptr)
+    {
+        MulticastPacket(toPeers, peerCount, enetPacket, channel);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+
+inline void SendMessage(ENetPeer* toPeer, const void* message, const size_t messageSize, const enet_uint32 channel, PacketBufferPool& packetBufferPool)
+{
+    MulticastMessage(&toPeer, 1, message, messageSize, channel, packetBufferPool);
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // PACKET_BUFFER_POOL_H
@@ -0,0 +1,103 @@
+///------------------------------------------------------------------------------------------------
+///  ParallelCollisions.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef PARALLEL_COLLISIONS_H
+#define PARALLEL_COLLISIONS_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/JobPool.h>
+#include <net_common/NetworkQuadtree.h>
+#include <net_common/ObjectTable.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// Colliding pair of objects, with the smaller id first.
+using ObjectIdPair = std::pair<objectId_t, objectId_t>;
+
+///------------------------------------------------------------------------------------------------
+/// Multithreaded NetworkQuadtree::FindAllCollidingPairs. The (read only) tree's nodes are spread
+/// across the job pool, every thread collects the pairs reported from its nodes in its own
+/// buffer, and the buffers are then merged and sorted. The output is therefore the same for any
+/// thread count and scheduling, which keeps the game logic consuming it reproducible.
+///
+/// Keep one around (per tree) so that its buffers are reused across ticks.
+class ParallelCollisionPass final
+{
+public:
+    /// Clears and fills outCollidingPairs, sorted by (lhs id, rhs id). netObjectData must be the
+    /// vector the tree was populated from.
+    inline void FindAllCollidingPairs(const NetworkQuadtree& quadtree, const std::vector<ObjectData>& netObjectData, JobPool& jobPool, std::vector<ObjectIdPair>& outCollidingPairs)
+    {
+        InternalFindAllCollidingPairs(quadtree, jobPool, outCollidingPairs, [&](const NetworkQuadtree& node, std::vector<ObjectIdPair>& threadPairs)
+        {
+            node.FindNodeCollidingPairs(netObjectData, [&](const ObjectData& lhs, const ObjectData& rhs)
+            {
+                threadPairs.emplace_back(math::Min(lhs.objectId, rhs.objectId), math::Max(lhs.objectId, rhs.objectId));
+            });
+        });
+    }
+    
+    /// Same as above for trees populated from an ObjectTable.
+    inline void FindAllCollidingPairs(const NetworkQuadtree& quadtree, const ObjectTable& objectTable, JobPool& jobPool, std::vector<ObjectIdPair>& outCollidingPairs)
+    {
+        const auto& objectIds = objectTable.GetObjectIds();
+        InternalFindAllCollidingPairs(quadtree, jobPool, outCollidingPairs, [&](const NetworkQuadtree& node, std::vector<ObjectIdPair>& threadPairs)
+        {
+            node.FindNodeCollidingPairs(objectTable, [&](const size_t lhsObjectIndex, const size_t rhsObjectIndex)
+            {
+                threadPairs.emplace_back(math::Min(objectIds[lhsObjectIndex], objectIds[rhsObjectIndex]), math::Max(objectIds[lhsObjectIndex], objectIds[rhsObjectIndex]));
+            });
+        });
+    }
+
+private:
+    template<typename NodePairsFunctionT>
+    inline void InternalFindAllCollidingPairs(const NetworkQuadtree& quadtree, JobPool& jobPool, std::vector<ObjectIdPair>& outCollidingPairs, NodePairsFunctionT&& nodePairsFunction)
+    {
+        mNodes.clear();
+        quadtree.CollectNodes(mNodes);
+
+        mThreadPairs.resize(jobPool.GetThreadCount());
+        for (auto& threadPairs: mThreadPairs)
+        {
+            threadPairs.clear();
+        }
+
+        jobPool.ParallelFor(mNodes.size(), [&](const size_t threadIndex, const size_t nodeIndex)
+        {
+            nodePairsFunction(*mNodes[nodeIndex], mThreadPairs[threadIndex]);
+        });
+
+        outCollidingPairs.clear();
+        for (const auto& threadPairs: mThreadPairs)
+        {
+            outCollidingPairs.insert(outCollidingPairs.end(), threadPairs.begin(), threadPairs.end());
+        }
+
+        std::sort(outCollidingPairs.begin(), outCollidingPairs.end());
+    }
+
+private:
+    std::vector<const NetworkQuadtree*> mNodes;
+    std::vector<std::vector<ObjectIdPair>> mThreadPairs;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // PARALLEL_COLLISIONS_H
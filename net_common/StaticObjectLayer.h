@@ -0,0 +1,105 @@
+///------------------------------------------------------------------------------------------------
+///  StaticObjectLayer.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef StaticObjectLayer_h
+#define StaticObjectLayer_h
+
+///------------------------------------------------------------------------------------------------
+
+#if __has_include(<engine/utils/MathUtils.h>)
+#include <engine/utils/MathUtils.h>
+#else
+#include "../util/MathUtils.h"
+#endif
+
+#include <net_common/NetworkCommon.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+///-----------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///-----------------------------------------------------------------------------------------------
+
+inline constexpr int STATIC_LAYER_NODE_CAPACITY = 8;
+
+///-----------------------------------------------------------------------------------------------
+/// Immutable broadphase for ObjectType::STATIC objects, built once per map load rather than
+/// every tick. It's a packed R-tree bulk loaded with sort-tile-recursive: the objects are
+/// sorted into spatially compact runs of STATIC_LAYER_NODE_CAPACITY, and every level above
+/// groups runs of the level below the same way. Entries and nodes each live in one
+/// contiguous array, with the children of a node always being consecutive, and every node
+/// is full except for the last one of each level.
+///
+/// Query semantics (overlap or touch of the collider rectangles) match NetworkQuadtree's.
+class StaticObjectLayer final
+{
+public:
+    StaticObjectLayer();
+    
+    // Replaces the layer's contents with the STATIC objects of netObjectData (others are skipped).
+    void Build(const std::vector<ObjectData>& netObjectData);
+    void Clear();
+    
+    size_t GetObjectCount() const;
+    
+    // Copies of the static objects, in layer order.
+    const std::vector<ObjectData>& GetObjects() const;
+    
+    // Visitor signature: void(const objectId_t objectId, const glm::vec3& position, const glm::vec3& dimensions)
+    template<typename VisitorT> void ForEachObjectInRect(const glm::vec3& rectOrigin, const glm::vec3& rectDimensions, VisitorT&& visitor) const;
+    template<typename VisitorT> void ForEachObjectInRadius(const glm::vec3& center, const float radius, VisitorT&& visitor) const;
+    
+    // Static objects whose collider rectangle overlaps the object's, other than the object itself.
+    // Visitor signature: void(const objectId_t candidateObjectId)
+    template<typename ObjectT, typename VisitorT> void ForEachCollisionCandidate(const ObjectT& objectData, VisitorT&& visitor) const;
+    
+    // Same as above with collision::CollidersIntersect run as the narrow phase. ObjectT is ObjectData or
+    // anything else with its collider members (e.g. ObjectColliderView).
+    // Visitor signature: void(const ObjectData& staticObjectData)
+    template<typename ObjectT, typename VisitorT> void ForEachCollidingObject(const ObjectT& objectData, VisitorT&& visitor) const;
+    
+    std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugRenderRectangles() const;
+
+private:
+    struct StaticEntry
+    {
+        objectId_t mObjectId;
+        glm::vec3 mObjectPosition;
+        glm::vec3 mObjectDimensions;
+    };
+    
+    struct StaticNode
+    {
+        glm::vec2 mMin;
+        glm::vec2 mMax;
+        uint32_t mFirstChildIndex; // In mEntries for leaves, in mNodes otherwise
+        uint16_t mChildCount;
+        bool mIsLeaf;
+    };
+    
+    template<typename CenterGetterT>
+    static void SortTileRecursive(std::vector<uint32_t>& itemIndices, CenterGetterT&& centerGetter);
+    template<typename OverlapPredicateT, typename VisitorT>
+    void InternalForEachEntryInRegion(const uint32_t nodeIndex, const glm::vec2& regionMin, const glm::vec2& regionMax, OverlapPredicateT& overlapPredicate, VisitorT& visitor) const;
+
+private:
+    std::vector<StaticEntry> mEntries;   // Parallel to mObjects
+    std::vector<ObjectData> mObjects;
+    std::vector<StaticNode> mNodes;      // Levels bottom up, the root last
+};
+
+///------------------------------------------------------------------------------------------------
+
+#include "StaticObjectLayer.inc"
+
+};
+#endif /* StaticObjectLayer_h */
@@ -0,0 +1,317 @@
+///------------------------------------------------------------------------------------------------
+///  SweptQueries.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef SWEPT_QUERIES_H
+#define SWEPT_QUERIES_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/JobPool.h>
+#include <net_common/Navmap.h>
+#include <net_common/NetworkQuadtree.h>
+#include <cmath>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+enum class SweptHitType
+{
+    NONE,
+    OBJECT,
+    NAVMAP_TILE
+};
+
+///------------------------------------------------------------------------------------------------
+/// A circle (or a point, for a radius of 0) moving from mStart to mEnd over a tick.
+struct SweptQuery
+{
+    glm::vec3 mStart;
+    glm::vec3 mEnd;
+    float mRadius;
+    objectId_t mObjectId;       // Never hit, e.g. the projectile itself
+    objectId_t mParentObjectId; // Never hit either, e.g. the caster of the projectile
+};
+
+///------------------------------------------------------------------------------------------------
+
+struct SweptHit
+{
+    SweptHitType mHitType = SweptHitType::NONE;
+    float mTimeOfImpact = 1.0f; // Segment parameter in [0, 1]
+    glm::vec3 mPosition;        // Of the query's center at the time of impact (mEnd if nothing was hit)
+    objectId_t mObjectId = 0;   // For OBJECT hits
+    glm::ivec2 mNavmapCoord;    // For NAVMAP_TILE hits
+};
+
+///------------------------------------------------------------------------------------------------
+/// What swept queries run against. Either the objects or the navmap can be left out.
+template<typename NavmapT = Navmap>
+struct SweptQueryScene
+{
+    const NetworkQuadtree* mQuadtree = nullptr;
+    const std::vector<ObjectData>* mNetObjectData = nullptr; // The vector mQuadtree was populated from
+    const NavmapT* mNavmap = nullptr;
+    glm::vec2 mMapPosition = glm::vec2(0.0f);
+    float mMapScale = MAP_GAME_SCALE;
+    NavmapTileType mBlockingTileType = NavmapTileType::SOLID;
+};
+
+///------------------------------------------------------------------------------------------------
+/// The query of a projectile moving to nextPosition this tick, swept with its collider's radius.
+inline SweptQuery CreateProjectileSweptQuery(const ObjectData& projectileData, const glm::vec3& nextPosition)
+{
+    const auto colliderRadius = projectileData.objectScale * math::Max(projectileData.colliderData.colliderRelativeDimensions.x, projectileData.colliderData.colliderRelativeDimensions.y) / 2.0f;
+    return SweptQuery{ projectileData.position, nextPosition, colliderRadius, projectileData.objectId, projectileData.parentObjectId };
+}
+
+///------------------------------------------------------------------------------------------------
+/// Narrows [minTime, maxTime] down to the part of the segment within the circle. Returns false
+/// if nothing is left.
+inline bool ClipSegmentToCircle(const glm::vec2& start, const glm::vec2& delta, const glm::vec2& center, const float radius, float& minTime, float& maxTime)
+{
+    const glm::vec2 startOffset(start.x - center.x, start.y - center.y);
+    const auto a = delta.x * delta.x + delta.y * delta.y;
+    const auto b = startOffset.x * delta.x + startOffset.y * delta.y;
+    const auto c = startOffset.x * startOffset.x + startOffset.y * startOffset.y - radius * radius;
+    if (a == 0.0f)
+    {
+        return c <= 0.0f && minTime <= maxTime;
+    }
+    
+    const auto discriminant = b * b - a * c;
+    if (discriminant < 0.0f)
+    {
+        return false;
+    }
+    
+    const auto discriminantRoot = std::sqrt(discriminant);
+    minTime = math::Max(minTime, (-b - discriminantRoot) / a);
+    maxTime = math::Min(maxTime, (-b + discriminantRoot) / a);
+    return minTime <= maxTime;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Same as above for an axis aligned rectangle.
+inline bool ClipSegmentToRect(const glm::vec2& start, const glm::vec2& delta, const glm::vec2& center, const glm::vec2& halfDimensions, float& minTime, float& maxTime)
+{
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        const auto axisStart = axis == 0 ? start.x : start.y;
+        const auto axisDelta = axis == 0 ? delta.x : delta.y;
+        const auto axisMin = axis == 0 ? center.x - halfDimensions.x : center.y - halfDimensions.y;
+        const auto axisMax = axis == 0 ? center.x + halfDimensions.x : center.y + halfDimensions.y;
+        if (axisDelta == 0.0f)
+        {
+            if (axisStart < axisMin || axisStart > axisMax)
+            {
+                return false;
+            }
+            continue;
+        }
+        
+        const auto lowTime = (axisMin - axisStart) / axisDelta;
+        const auto highTime = (axisMax - axisStart) / axisDelta;
+        minTime = math::Max(minTime, math::Min(lowTime, highTime));
+        maxTime = math::Min(maxTime, math::Max(lowTime, highTime));
+    }
+    
+    return minTime <= maxTime;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Grid walk (Amanatides & Woo DDA) over the navmap tiles a segment crosses, in the order it
+/// crosses them, finding the first one of tileType. Every crossed tile is visited, so thin walls
+/// can't be skipped however long the segment is. Parts of the segment outside the navmap are
+/// ignored. Works with Navmap and PackedNavmap.
+template<typename NavmapT>
+inline bool RaycastNavmap(const NavmapT& navmap, const glm::vec2& mapPosition, const float mapScale, const glm::vec3& start, const glm::vec3& end, float& outTimeOfImpact, glm::ivec2& outNavmapCoord, const NavmapTileType tileType = NavmapTileType::SOLID)
+{
+    NET_STATS_ADD(NetStatCounter::NAVMAP_RAYCASTS, 1);
+    
+    // Continuous navmap coordinates, with the same mapping as Navmap::GetNavmapCoord (i.e. y pointing down)
+    const auto navmapSize = navmap.GetSize();
+    const glm::vec2 navmapStart(((start.x - mapPosition.x * mapScale) / mapScale + 0.5f) * navmapSize, (0.5f - (start.y - mapPosition.y * mapScale) / mapScale) * navmapSize);
+    const glm::vec2 navmapEnd(((end.x - mapPosition.x * mapScale) / mapScale + 0.5f) * navmapSize, (0.5f - (end.y - mapPosition.y * mapScale) / mapScale) * navmapSize);
+    const glm::vec2 navmapDelta(navmapEnd.x - navmapStart.x, navmapEnd.y - navmapStart.y);
+    
+    // Clip the segment to the navmap
+    auto minTime = 0.0f;
+    auto maxTime = 1.0f;
+    const auto navmapHalfSize = navmapSize * 0.5f;
+    if (!ClipSegmentToRect(navmapStart, navmapDelta, glm::vec2(navmapHalfSize, navmapHalfSize), glm::vec2(navmapHalfSize, navmapHalfSize), minTime, maxTime))
+    {
+        return false;
+    }
+    
+    const glm::vec2 entryPoint(navmapStart.x + navmapDelta.x * minTime, navmapStart.y + navmapDelta.y * minTime);
+    glm::ivec2 navmapCoord(math::Max(0, math::Min(static_cast<int>(std::floor(entryPoint.x)), navmapSize - 1)), math::Max(0, math::Min(static_cast<int>(std::floor(entryPoint.y)), navmapSize - 1)));
+    
+    const glm::ivec2 step(navmapDelta.x > 0.0f ? 1 : -1, navmapDelta.y > 0.0f ? 1 : -1);
+    const glm::vec2 timeDelta(navmapDelta.x != 0.0f ? std::abs(1.0f / navmapDelta.x) : INFINITY, navmapDelta.y != 0.0f ? std::abs(1.0f / navmapDelta.y) : INFINITY);
+    glm::vec2 nextBoundaryTime(navmapDelta.x != 0.0f ? ((navmapDelta.x > 0.0f ? navmapCoord.x + 1 : navmapCoord.x) - navmapStart.x) / navmapDelta.x : INFINITY,
+                               navmapDelta.y != 0.0f ? ((navmapDelta.y > 0.0f ? navmapCoord.y + 1 : navmapCoord.y) - navmapStart.y) / navmapDelta.y : INFINITY);
+    
+    auto tileEntryTime = minTime;
+    while (tileEntryTime <= maxTime)
+    {
+        if (navmap.GetNavmapTileAt(navmapCoord) == tileType)
+        {
+            outTimeOfImpact = tileEntryTime;
+            outNavmapCoord = navmapCoord;
+            return true;
+        }
+        
+        if (nextBoundaryTime.x < nextBoundaryTime.y)
+        {
+            tileEntryTime = nextBoundaryTime.x;
+            nextBoundaryTime.x += timeDelta.x;
+            navmapCoord.x += step.x;
+        }
+        else
+        {
+            tileEntryTime = nextBoundaryTime.y;
+            nextBoundaryTime.y += timeDelta.y;
+            navmapCoord.y += step.y;
+        }
+        
+        if (navmapCoord.x < 0 || navmapCoord.y < 0 || navmapCoord.x >= navmapSize || navmapCoord.y >= navmapSize)
+        {
+            return false;
+        }
+    }
+    
+    return false;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Earliest hit of a swept query against the scene's navmap tiles and objects, so that fast
+/// projectiles can be resolved once per tick rather than sub-stepped. The navmap is walked with
+/// the query's center (RaycastNavmap). Objects are hit when the swept circle reaches their
+/// collider rectangle grown by the query's radius, and for circle colliders also the grown
+/// collider circle. Only objects for which hitFilter(const ObjectData&) returns true are
+/// considered.
+template<typename NavmapT, typename HitFilterT>
+inline SweptHit FindFirstSweptHit(const SweptQueryScene<NavmapT>& scene, const SweptQuery& query, HitFilterT&& hitFilter)
+{
+    SweptHit hit;
+    
+    float tileTimeOfImpact = 0.0f;
+    glm::ivec2 tileNavmapCoord;
+    if (scene.mNavmap && RaycastNavmap(*scene.mNavmap, scene.mMapPosition, scene.mMapScale, query.mStart, query.mEnd, tileTimeOfImpact, tileNavmapCoord, scene.mBlockingTileType))
+    {
+        hit.mHitType = SweptHitType::NAVMAP_TILE;
+        hit.mTimeOfImpact = tileTimeOfImpact;
+        hit.mNavmapCoord = tileNavmapCoord;
+    }
+    
+    if (scene.mQuadtree && scene.mNetObjectData)
+    {
+        const auto& netObjectData = *scene.mNetObjectData;
+        const glm::vec2 start(query.mStart.x, query.mStart.y);
+        const glm::vec2 delta(query.mEnd.x - query.mStart.x, query.mEnd.y - query.mStart.y);
+        scene.mQuadtree->ForEachObjectAlongSegment(query.mStart, query.mEnd, query.mRadius, [&](const objectId_t objectId, const size_t objectIndex, float timeOfImpact)
+        {
+            if (objectIndex >= netObjectData.size() || objectId == query.mObjectId || objectId == query.mParentObjectId || timeOfImpact >= hit.mTimeOfImpact)
+            {
+                return hit.mTimeOfImpact;
+            }
+            
+            const auto& objectData = netObjectData[objectIndex];
+            if (!hitFilter(objectData))
+            {
+                return hit.mTimeOfImpact;
+            }
+            
+            // Like the broadphase then CollidersIntersect, circle colliders need both their grown rectangle and circle
+            // to be reached, which also keeps the time of impact from going below the one the quadtree reported.
+            if (objectData.colliderData.colliderType == ColliderType::CIRCLE)
+            {
+                const glm::vec2 objectCenter(objectData.position.x, objectData.position.y);
+                const glm::vec2 grownHalfDimensions(objectData.colliderData.colliderRelativeDimensions.x * objectData.objectScale / 2.0f + query.mRadius, objectData.colliderData.colliderRelativeDimensions.y * objectData.objectScale / 2.0f + query.mRadius);
+                const auto grownRadius = objectData.objectScale * objectData.colliderData.colliderRelativeDimensions.x / 2.0f + query.mRadius;
+                auto maxTime = hit.mTimeOfImpact;
+                if (!ClipSegmentToRect(start, delta, objectCenter, grownHalfDimensions, timeOfImpact, maxTime) ||
+                    !ClipSegmentToCircle(start, delta, objectCenter, grownRadius, timeOfImpact, maxTime) ||
+                    timeOfImpact >= hit.mTimeOfImpact)
+                {
+                    return hit.mTimeOfImpact;
+                }
+            }
+            
+            hit.mHitType = SweptHitType::OBJECT;
+            hit.mTimeOfImpact = timeOfImpact;
+            hit.mObjectId = objectId;
+            return hit.mTimeOfImpact;
+        });
+    }
+    
+    hit.mPosition = query.mStart + (query.mEnd - query.mStart) * hit.mTimeOfImpact;
+    return hit;
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename NavmapT>
+inline SweptHit FindFirstSweptHit(const SweptQueryScene<NavmapT>& scene, const SweptQuery& query)
+{
+    return FindFirstSweptHit(scene, query, [](const ObjectData&){ return true; });
+}
+
+///------------------------------------------------------------------------------------------------
+/// Batched FindFirstSweptHit, e.g. for all projectiles of a tick. outHits is resized to, and
+/// filled in the order of, queries.
+template<typename NavmapT, typename HitFilterT>
+inline void FindFirstSweptHits(const SweptQueryScene<NavmapT>& scene, const std::vector<SweptQuery>& queries, std::vector<SweptHit>& outHits, HitFilterT&& hitFilter)
+{
+    outHits.resize(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        outHits[i] = FindFirstSweptHit(scene, queries[i], hitFilter);
+    }
+}
+
+///------------------------------------------------------------------------------------------------
+/// Same as above, with the queries spread across the job pool. hitFilter must be safe to call
+/// from several threads at once.
+template<typename NavmapT, typename HitFilterT>
+inline void FindFirstSweptHits(const SweptQueryScene<NavmapT>& scene, const std::vector<SweptQuery>& queries, JobPool& jobPool, std::vector<SweptHit>& outHits, HitFilterT&& hitFilter)
+{
+    outHits.resize(queries.size());
+    jobPool.ParallelFor(queries.size(), [&](const size_t, const size_t queryIndex)
+    {
+        outHits[queryIndex] = FindFirstSweptHit(scene, queries[queryIndex], hitFilter);
+    });
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename NavmapT>
+inline void FindFirstSweptHits(const SweptQueryScene<NavmapT>& scene, const std::vector<SweptQuery>& queries, std::vector<SweptHit>& outHits)
+{
+    FindFirstSweptHits(scene, queries, outHits, [](const ObjectData&){ return true; });
+}
+
+///------------------------------------------------------------------------------------------------
+
+template<typename NavmapT>
+inline void FindFirstSweptHits(const SweptQueryScene<NavmapT>& scene, const std::vector<SweptQuery>& queries, JobPool& jobPool, std::vector<SweptHit>& outHits)
+{
+    FindFirstSweptHits(scene, queries, jobPool, outHits, [](const ObjectData&){ return true; });
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // SWEPT_QUERIES_H
@@ -0,0 +1,330 @@
+///------------------------------------------------------------------------------------------------
+///  WorldHistory.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef WORLD_HISTORY_H
+#define WORLD_HISTORY_H
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/NetworkCommon.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+
+inline constexpr float DEFAULT_WORLD_HISTORY_DURATION_SECS = 0.5f;
+inline constexpr uint32_t INVALID_WORLD_HISTORY_TICK = 0xFFFFFFFF; // Newest/oldest tick of an empty history
+
+///------------------------------------------------------------------------------------------------
+/// The part of an ObjectData that hit detection needs, as recorded for a past tick.
+struct ObjectHistoryState
+{
+    objectId_t mObjectId;
+    glm::vec2 mPosition;
+    glm::vec2 mColliderRelativeDimensions;
+    float mObjectScale;
+    ColliderType mColliderType;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Fixed capacity ring of per tick object states, for lag compensated hit detection: attacks
+/// are resolved against the world as the attacker saw it (i.e. rewound by their latency)
+/// rather than against the current tick. All storage is allocated up front, so recording a
+/// tick only writes into the oldest tick's slot.
+///
+///     history.BeginTick(tick);
+///     for (const auto& [objectId, objectData]: objects) history.RecordObject(objectData);
+///     history.EndTick();
+///     ...
+///     history.ForEachIntersectingObject(attackData, attackerTick, attackerTickFraction, visitor);
+///
+/// Rewound queries are a linear pass over the recorded objects of the tick with the same
+/// CollidersIntersect semantics as the live world, which for a single attack is cheaper than
+/// rebuilding a NetworkQuadtree for a past tick.
+class WorldHistory final
+{
+public:
+    WorldHistory(const size_t tickCapacity, const size_t maxObjectsPerTick)
+    : mTicks(math::Max(tickCapacity, size_t(2)))
+    , mStates(mTicks.size() * maxObjectsPerTick)
+    , mMaxObjectsPerTick(maxObjectsPerTick)
+    , mNewestTickSlot(0)
+    , mRecordedTickCount(0)
+    , mIsRecordingTick(false)
+    {
+    }
+    
+    /// Ticks needed to cover historyDurationSecs (plus the one being interpolated from).
+    static inline size_t GetTickCapacityForDuration(const float historyDurationSecs, const float tickDurationSecs)
+    {
+        return static_cast<size_t>(std::ceil(historyDurationSecs / tickDurationSecs)) + 1;
+    }
+    
+    /// Starts recording a tick, overwriting the oldest one once the ring is full. Ticks need to
+    /// be recorded in increasing order, although not necessarily consecutively.
+    inline bool BeginTick(const uint32_t tick)
+    {
+        if (mIsRecordingTick || (mRecordedTickCount > 0 && tick <= mTicks[mNewestTickSlot].mTick))
+        {
+            return false;
+        }
+        
+        mNewestTickSlot = mRecordedTickCount == 0 ? 0 : (mNewestTickSlot + 1) % mTicks.size();
+        mRecordedTickCount = math::Min(mRecordedTickCount + 1, mTicks.size());
+        mTicks[mNewestTickSlot].mTick = tick;
+        mTicks[mNewestTickSlot].mStateCount = 0;
+        mIsRecordingTick = true;
+        return true;
+    }
+    
+    /// Returns false if the tick is already at maxObjectsPerTick.
+    inline bool RecordObject(const ObjectData& objectData)
+    {
+        auto& tickEntry = mTicks[mNewestTickSlot];
+        if (!mIsRecordingTick || tickEntry.mStateCount == mMaxObjectsPerTick)
+        {
+            return false;
+        }
+        
+        auto& objectState = mStates[mNewestTickSlot * mMaxObjectsPerTick + tickEntry.mStateCount++];
+        objectState.mObjectId = objectData.objectId;
+        objectState.mPosition = glm::vec2(objectData.position.x, objectData.position.y);
+        objectState.mColliderRelativeDimensions = objectData.colliderData.colliderRelativeDimensions;
+        objectState.mObjectScale = objectData.objectScale;
+        objectState.mColliderType = objectData.colliderData.colliderType;
+        return true;
+    }
+    
+    inline void EndTick()
+    {
+        if (!mIsRecordingTick)
+        {
+            return;
+        }
+        
+        // Sorted by id so that the same object can be looked up in the next tick when interpolating.
+        // Objects usually come in the same order every tick, which is_sorted catches cheaply.
+        auto* statesBegin = &mStates[mNewestTickSlot * mMaxObjectsPerTick];
+        auto* statesEnd = statesBegin + mTicks[mNewestTickSlot].mStateCount;
+        auto compareIds = [](const ObjectHistoryState& lhs, const ObjectHistoryState& rhs){ return lhs.mObjectId < rhs.mObjectId; };
+        if (!std::is_sorted(statesBegin, statesEnd, compareIds))
+        {
+            std::sort(statesBegin, statesEnd, compareIds);
+        }
+        
+        mIsRecordingTick = false;
+    }
+    
+    inline void Clear()
+    {
+        mRecordedTickCount = 0;
+        mNewestTickSlot = 0;
+        mIsRecordingTick = false;
+    }
+    
+    inline bool IsEmpty() const { return GetCompletedTickCount() == 0; }
+    inline size_t GetTickCapacity() const { return mTicks.size(); }
+    inline size_t GetMaxObjectsPerTick() const { return mMaxObjectsPerTick; }
+    inline uint32_t GetNewestTick() const { return IsEmpty() ? INVALID_WORLD_HISTORY_TICK : mTicks[GetNewestCompletedTickSlot()].mTick; }
+    inline uint32_t GetOldestTick() const { return IsEmpty() ? INVALID_WORLD_HISTORY_TICK : mTicks[GetTickSlot(0)].mTick; }
+    
+    /// Interpolated state of an object at tick + tickFraction (in [0, 1)), clamped to the
+    /// recorded history. Returns false if the object is not recorded at the rewound tick.
+    inline bool GetObjectState(const objectId_t objectId, const uint32_t tick, const float tickFraction, ObjectHistoryState& outObjectState) const
+    {
+        RewoundTicks rewoundTicks;
+        if (!ResolveRewoundTicks(tick, tickFraction, rewoundTicks))
+        {
+            return false;
+        }
+        
+        const auto* objectState = FindObjectState(rewoundTicks.mFromSlot, objectId);
+        if (objectState == nullptr)
+        {
+            return false;
+        }
+        
+        outObjectState = InterpolateObjectState(*objectState, FindObjectState(rewoundTicks.mToSlot, objectId), rewoundTicks.mAlpha);
+        return true;
+    }
+    
+    /// Calls visitor(const ObjectHistoryState&) for every object that, at the rewound tick,
+    /// CollidersIntersect with objectData (excluding objectData.objectId itself). Objects are
+    /// the ones recorded at the earlier of the two interpolated ticks.
+    template<typename VisitorT>
+    inline void ForEachIntersectingObject(const ObjectData& objectData, const uint32_t tick, const float tickFraction, VisitorT&& visitor) const
+    {
+        RewoundTicks rewoundTicks;
+        if (!ResolveRewoundTicks(tick, tickFraction, rewoundTicks))
+        {
+            return;
+        }
+        
+        ObjectData rewoundObjectData;
+        rewoundObjectData.position.z = 0.0f;
+        const auto queryRadius = GetBoundingHalfExtent(objectData.objectScale, objectData.colliderData.colliderRelativeDimensions);
+        
+        // Both ticks are sorted by id, so the interpolation targets are found by walking the next tick alongside
+        const auto* statesBegin = &mStates[rewoundTicks.mFromSlot * mMaxObjectsPerTick];
+        const auto* statesEnd = statesBegin + mTicks[rewoundTicks.mFromSlot].mStateCount;
+        const auto* toStatesIter = &mStates[rewoundTicks.mToSlot * mMaxObjectsPerTick];
+        const auto* toStatesEnd = toStatesIter + mTicks[rewoundTicks.mToSlot].mStateCount;
+        for (const auto* objectState = statesBegin; objectState != statesEnd; ++objectState)
+        {
+            while (toStatesIter != toStatesEnd && toStatesIter->mObjectId < objectState->mObjectId)
+            {
+                ++toStatesIter;
+            }
+            
+            if (objectState->mObjectId == objectData.objectId)
+            {
+                continue;
+            }
+            
+            const auto* toObjectState = toStatesIter != toStatesEnd && toStatesIter->mObjectId == objectState->mObjectId ? &(*toStatesIter) : nullptr;
+            const auto rewoundObjectState = InterpolateObjectState(*objectState, toObjectState, rewoundTicks.mAlpha);
+            
+            // Conservative reject before the exact test, as most of the world is nowhere near the query
+            const auto maxCenterDistance = queryRadius + GetBoundingHalfExtent(rewoundObjectState.mObjectScale, rewoundObjectState.mColliderRelativeDimensions);
+            if (std::abs(rewoundObjectState.mPosition.x - objectData.position.x) > maxCenterDistance || std::abs(rewoundObjectState.mPosition.y - objectData.position.y) > maxCenterDistance)
+            {
+                continue;
+            }
+            
+            rewoundObjectData.objectId = rewoundObjectState.mObjectId;
+            rewoundObjectData.position.x = rewoundObjectState.mPosition.x;
+            rewoundObjectData.position.y = rewoundObjectState.mPosition.y;
+            rewoundObjectData.colliderData.colliderType = rewoundObjectState.mColliderType;
+            rewoundObjectData.colliderData.colliderRelativeDimensions = rewoundObjectState.mColliderRelativeDimensions;
+            rewoundObjectData.objectScale = rewoundObjectState.mObjectScale;
+            
+            if (CollidersIntersect(objectData, rewoundObjectData))
+            {
+                visitor(rewoundObjectState);
+            }
+        }
+    }
+    
+    /// Clears and fills outObjectIds with the ids of the intersecting objects at the rewound tick.
+    inline void GetIntersectingObjects(const ObjectData& objectData, const uint32_t tick, const float tickFraction, std::vector<objectId_t>& outObjectIds) const
+    {
+        outObjectIds.clear();
+        ForEachIntersectingObject(objectData, tick, tickFraction, [&](const ObjectHistoryState& objectState){ outObjectIds.push_back(objectState.mObjectId); });
+    }
+
+private:
+    struct TickEntry
+    {
+        uint32_t mTick = 0;
+        size_t mStateCount = 0;
+    };
+    
+    struct RewoundTicks
+    {
+        size_t mFromSlot;
+        size_t mToSlot;
+        float mAlpha;
+    };
+    
+    inline size_t GetCompletedTickCount() const
+    {
+        return mIsRecordingTick ? mRecordedTickCount - 1 : mRecordedTickCount;
+    }
+    
+    inline size_t GetNewestCompletedTickSlot() const
+    {
+        return mIsRecordingTick ? (mNewestTickSlot + mTicks.size() - 1) % mTicks.size() : mNewestTickSlot;
+    }
+    
+    /// Slot of the i-th oldest completed tick.
+    inline size_t GetTickSlot(const size_t tickAge) const
+    {
+        return (GetNewestCompletedTickSlot() + mTicks.size() - (GetCompletedTickCount() - 1 - tickAge)) % mTicks.size();
+    }
+    
+    inline bool ResolveRewoundTicks(const uint32_t tick, const float tickFraction, RewoundTicks& outRewoundTicks) const
+    {
+        const auto completedTickCount = GetCompletedTickCount();
+        if (completedTickCount == 0)
+        {
+            return false;
+        }
+        
+        // Rewinding is capped to the recorded window, and to the newest tick going forwards
+        const auto rewoundTime = static_cast<double>(tick) + math::Max(0.0, math::Min(static_cast<double>(tickFraction), 1.0));
+        if (rewoundTime <= mTicks[GetTickSlot(0)].mTick || completedTickCount == 1)
+        {
+            outRewoundTicks = RewoundTicks{ GetTickSlot(0), GetTickSlot(0), 0.0f };
+            return true;
+        }
+        
+        for (size_t i = 1; i < completedTickCount; ++i)
+        {
+            const auto toSlot = GetTickSlot(i);
+            if (rewoundTime < mTicks[toSlot].mTick)
+            {
+                const auto fromSlot = GetTickSlot(i - 1);
+                const auto fromTick = static_cast<double>(mTicks[fromSlot].mTick);
+                outRewoundTicks = RewoundTicks{ fromSlot, toSlot, static_cast<float>((rewoundTime - fromTick) / (mTicks[toSlot].mTick - fromTick)) };
+                return true;
+            }
+        }
+        
+        const auto newestSlot = GetNewestCompletedTickSlot();
+        outRewoundTicks = RewoundTicks{ newestSlot, newestSlot, 0.0f };
+        return true;
+    }
+    
+    inline const ObjectHistoryState* FindObjectState(const size_t tickSlot, const objectId_t objectId) const
+    {
+        const auto* statesBegin = &mStates[tickSlot * mMaxObjectsPerTick];
+        const auto* statesEnd = statesBegin + mTicks[tickSlot].mStateCount;
+        const auto* objectState = std::lower_bound(statesBegin, statesEnd, objectId, [](const ObjectHistoryState& state, const objectId_t id){ return state.mObjectId < id; });
+        return objectState != statesEnd && objectState->mObjectId == objectId ? objectState : nullptr;
+    }
+    
+    /// Objects destroyed by the next tick (no toObjectState) stay where they were last seen.
+    static inline ObjectHistoryState InterpolateObjectState(const ObjectHistoryState& fromObjectState, const ObjectHistoryState* toObjectState, const float alpha)
+    {
+        if (toObjectState == nullptr || alpha <= 0.0f)
+        {
+            return fromObjectState;
+        }
+        
+        auto objectState = fromObjectState;
+        objectState.mPosition = fromObjectState.mPosition + (toObjectState->mPosition - fromObjectState.mPosition) * alpha;
+        return objectState;
+    }
+    
+    /// Bounds the reach of every collider type from its center, given how CollidersIntersect uses the dimensions.
+    static inline float GetBoundingHalfExtent(const float objectScale, const glm::vec2& colliderRelativeDimensions)
+    {
+        return std::abs(objectScale) * math::Max(std::abs(colliderRelativeDimensions.x), std::abs(colliderRelativeDimensions.y)) / 2.0f;
+    }
+
+private:
+    std::vector<TickEntry> mTicks;
+    std::vector<ObjectHistoryState> mStates; // mMaxObjectsPerTick states per tick slot
+    const size_t mMaxObjectsPerTick;
+    size_t mNewestTickSlot;
+    size_t mRecordedTickCount;
+    bool mIsRecordingTick;
+};
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif // WORLD_HISTORY_H
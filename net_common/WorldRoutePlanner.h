@@ -0,0 +1,149 @@
+///------------------------------------------------------------------------------------------------
+///  WorldRoutePlanner.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef WorldRoutePlanner_h
+#define WorldRoutePlanner_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/MapGlobalData.h>
+#include <net_common/NavmapFlowField.h>
+#include <net_common/NavmapPathfinder.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+namespace network
+{
+
+///------------------------------------------------------------------------------------------------
+/// One map's stretch of a cross map route, in that map's navmap coords. Consecutive legs
+/// are joined by a single step across the shared map edge.
+struct WorldRouteLeg
+{
+    std::string mMapName;
+    glm::ivec2 mStartCoord;
+    glm::ivec2 mEndCoord;
+};
+
+///------------------------------------------------------------------------------------------------
+
+struct WorldRoute
+{
+    std::vector<WorldRouteLeg> mLegs;
+    float mCost = 0.0f;
+};
+
+///------------------------------------------------------------------------------------------------
+/// Hierarchical (HPA* style) route planner across the maps of map_global_data.json.
+///
+/// Each map only covers the centred region of its navmap given by its dimensions (the rest
+/// is treated as impassable). Contiguous runs of passable tiles along the region edge facing
+/// a connected map, with a passable tile right across the edge, form a portal. The portal to
+/// portal costs within each map are computed once in BuildPortalGraph, so a route query only
+/// searches the small portal graph, plus one flow field build on the goal map. The per map
+/// paths are then refined lazily, one leg at a time, when an agent actually gets there.
+class WorldRoutePlanner final
+{
+public:
+    WorldRoutePlanner(const MapGlobalData& mapGlobalData, const int navmapSize = NAVMAP_SIZE);
+    
+    /// Returns false for maps missing from the global data.
+    template<typename NavmapT>
+    bool AddMapNavmap(const std::string& mapName, const NavmapT& navmap, const PathfindingSettings& settings = PathfindingSettings());
+    
+    /// To be called once all navmaps have been added (and again if any of them changes).
+    void BuildPortalGraph();
+    
+    /// Finds the cheapest route from a tile of one map to a tile of another (or the same) map.
+    /// Not thread safe: the goal flow field is kept around for consecutive queries to the same goal.
+    bool FindRoute(const std::string& startMapName, const glm::ivec2& startCoord, const std::string& goalMapName, const glm::ivec2& goalCoord, WorldRoute& outRoute);
+    
+    /// Full tile path of a single leg within its map.
+    bool RefineRouteLeg(const WorldRouteLeg& routeLeg, std::vector<glm::ivec2>& outNavmapPath) const;
+    
+    const NavmapPathfinder* GetMapPathfinder(const std::string& mapName) const;
+    glm::ivec2 GetGlobalTileCoord(const std::string& mapName, const glm::ivec2& navmapCoord) const;
+    size_t GetPortalNodeCount() const;
+
+private:
+    struct PlannerMap
+    {
+        std::string mMapName;
+        MapDefinition mMapDefinition;
+        glm::ivec2 mGlobalTileOffset;
+        glm::ivec2 mRegionMin;
+        glm::ivec2 mRegionMax;
+        std::unique_ptr<NavmapPathfinder> mPathfinder;
+        std::vector<int> mPortalNodeIndices;
+        std::vector<float> mPortalCosts;             // [from * portalCount + to], within the map
+        std::vector<NavmapFlowField> mPortalFlowFields; // Goal = each portal node's tile
+    };
+    
+    struct PortalNode
+    {
+        int mMapIndex;
+        int mMapPortalIndex;
+        glm::ivec2 mNavmapCoord;
+        int mLinkedNodeIndex;
+        float mCrossingCost;
+    };
+    
+    /// Navmap adapter turning everything outside of the map's region into SOLID tiles.
+    template<typename NavmapT>
+    struct RegionNavmapView
+    {
+        const NavmapT& mNavmap;
+        glm::ivec2 mRegionMin;
+        glm::ivec2 mRegionMax;
+        
+        int GetSize() const { return mNavmap.GetSize(); }
+        NavmapTileType GetNavmapTileAt(const glm::ivec2& navmapCoord) const
+        {
+            const auto isInRegion = navmapCoord.x >= mRegionMin.x && navmapCoord.y >= mRegionMin.y && navmapCoord.x <= mRegionMax.x && navmapCoord.y <= mRegionMax.y;
+            return isInRegion ? mNavmap.GetNavmapTileAt(navmapCoord) : NavmapTileType::SOLID;
+        }
+    };
+    
+    struct OpenEntry
+    {
+        float mCost;
+        int mNodeIndex;
+    };
+    
+    int FindMapIndex(const std::string& mapName) const;
+    void FindMapPortals(const int mapIndex, const MapConnectionDirection direction, const int connectedMapIndex);
+    void AddPortal(const int mapIndex, const glm::ivec2& navmapCoord, const int connectedMapIndex, const glm::ivec2& connectedNavmapCoord);
+    void PushOpenEntry(const int nodeIndex, const float cost);
+    static bool IsLowerPriorityOpenEntry(const OpenEntry& lhs, const OpenEntry& rhs);
+
+private:
+    const int mNavmapSize;
+    std::vector<PlannerMap> mMaps;
+    std::unordered_map<std::string, int> mMapIndices;
+    std::vector<PortalNode> mPortalNodes;
+    
+    // Query state, reused across FindRoute calls
+    NavmapFlowField mGoalFlowField;
+    int mGoalFlowFieldMapIndex;
+    std::vector<float> mNodeCosts;
+    std::vector<int> mNodeParents;
+    std::vector<bool> mNodeClosed;
+    std::vector<OpenEntry> mOpenHeap;
+    std::vector<int> mReversedNodePath;
+};
+
+///------------------------------------------------------------------------------------------------
+
+#include "WorldRoutePlanner.inc"
+
+};
+
+#endif /* WorldRoutePlanner_h */
@@ -0,0 +1,180 @@
+///------------------------------------------------------------------------------------------------
+///  NetAssetCooker.cpp
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#include <net_common/CookedWorldAssets.h>
+#include <tools/PngLoader.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+///------------------------------------------------------------------------------------------------
+
+#ifndef NET_COMMON_ASSETS_DIR
+#define NET_COMMON_ASSETS_DIR "net_assets"
+#endif
+
+///------------------------------------------------------------------------------------------------
+
+struct CookerOptions
+{
+    std::string mAssetsDirectory = NET_COMMON_ASSETS_DIR;
+    std::string mOutputPath;
+};
+
+///------------------------------------------------------------------------------------------------
+
+static bool ParseOptions(int argc, char** argv, CookerOptions& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument(argv[i]);
+        auto readValue = [&](const char* prefix, std::string& outValue)
+        {
+            const auto prefixLength = std::strlen(prefix);
+            if (argument.compare(0, prefixLength, prefix) != 0)
+            {
+                return false;
+            }
+            
+            outValue = argument.substr(prefixLength);
+            return true;
+        };
+        
+        if (!readValue("--assets=", outOptions.mAssetsDirectory) && !readValue("--output=", outOptions.mOutputPath))
+        {
+            return false;
+        }
+    }
+    
+    if (outOptions.mOutputPath.empty())
+    {
+        outOptions.mOutputPath = outOptions.mAssetsDirectory + "/" + network::COOKED_WORLD_ASSETS_FILE_NAME;
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+/// Loads the cooked blob and checks that it classifies every tile the way the source navmaps
+/// do, and that it holds the same map global data. Runs before the blob is written, so that a
+/// bad blob never replaces the live one.
+static bool VerifyCookedWorldAssets(const std::vector<unsigned char>& cookedBlob, const network::MapGlobalData& mapGlobalData, const std::vector<network::CookedNavmapSource>& navmapSources)
+{
+    network::CookedWorldAssets cookedWorldAssets;
+    if (!cookedWorldAssets.LoadFromMemory(cookedBlob.data(), cookedBlob.size()) || !cookedWorldAssets.IsChecksumValid() || cookedWorldAssets.GetMapCount() != navmapSources.size())
+    {
+        return false;
+    }
+    
+    for (const auto& navmapSource: navmapSources)
+    {
+        const auto mapIndex = cookedWorldAssets.FindMapIndex(navmapSource.mMapName);
+        if (mapIndex == network::NO_COOKED_MAP_INDEX)
+        {
+            return false;
+        }
+        
+        const network::Navmap sourceNavmap(navmapSource.mNavmapPixels, navmapSource.mNavmapSize);
+        const auto cookedNavmap = cookedWorldAssets.GetNavmap(mapIndex);
+        const auto cookedPackedNavmap = cookedWorldAssets.GetPackedNavmap(mapIndex);
+        if (cookedNavmap.GetSize() != sourceNavmap.GetSize())
+        {
+            return false;
+        }
+        
+        for (int y = 0; y < sourceNavmap.GetSize(); ++y)
+        {
+            for (int x = 0; x < sourceNavmap.GetSize(); ++x)
+            {
+                const auto sourceTileType = sourceNavmap.GetNavmapTileAt(glm::ivec2(x, y));
+                if (cookedNavmap.GetNavmapTileAt(glm::ivec2(x, y)) != sourceTileType || cookedPackedNavmap.GetNavmapTileAt(glm::ivec2(x, y)) != sourceTileType)
+                {
+                    return false;
+                }
+            }
+        }
+        
+        const auto cookedMapDefinition = cookedWorldAssets.GetMapDefinition(mapIndex);
+        const auto* sourceMapDefinition = mapGlobalData.FindMapDefinition(navmapSource.mMapName);
+        if (cookedMapDefinition.mPosition != sourceMapDefinition->mPosition || cookedMapDefinition.mDimensions != sourceMapDefinition->mDimensions)
+        {
+            return false;
+        }
+        
+        for (int i = 0; i < static_cast<int>(network::MapConnectionDirection::COUNT); ++i)
+        {
+            const auto& sourceConnectedMap = sourceMapDefinition->mConnectedMaps[i];
+            const auto isSourceConnectionCooked = mapGlobalData.FindMapDefinition(sourceConnectedMap) != nullptr;
+            if (cookedMapDefinition.mConnectedMaps[i] != (isSourceConnectionCooked ? sourceConnectedMap : std::string()))
+            {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    CookerOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--assets=<net_assets dir>] [--output=<cooked file>]\n", argv[0]);
+        return 1;
+    }
+    
+    const auto mapGlobalDataPath = options.mAssetsDirectory + "/map_global_data.json";
+    network::MapGlobalData mapGlobalData;
+    if (!network::LoadMapGlobalData(mapGlobalDataPath, mapGlobalData))
+    {
+        std::fprintf(stderr, "Could not load %s\n", mapGlobalDataPath.c_str());
+        return 1;
+    }
+    
+    std::vector<std::vector<unsigned char>> navmapPixels(mapGlobalData.mMapDefinitions.size());
+    std::vector<network::CookedNavmapSource> navmapSources;
+    for (const auto& mapDefinitionEntry: mapGlobalData.mMapDefinitions)
+    {
+        const auto navmapPath = options.mAssetsDirectory + "/navmaps/" + network::GetMapNavmapFileName(mapDefinitionEntry.first);
+        auto& mapNavmapPixels = navmapPixels[navmapSources.size()];
+        
+        int navmapWidth = 0, navmapHeight = 0;
+        if (!tools::LoadPngRGBA(navmapPath, mapNavmapPixels, navmapWidth, navmapHeight) || navmapWidth != navmapHeight)
+        {
+            std::fprintf(stderr, "Could not load navmap %s\n", navmapPath.c_str());
+            return 1;
+        }
+        
+        navmapSources.push_back(network::CookedNavmapSource{ mapDefinitionEntry.first, mapNavmapPixels.data(), navmapWidth });
+    }
+    
+    std::vector<unsigned char> cookedBlob;
+    if (!network::CookWorldAssets(mapGlobalData, navmapSources, cookedBlob))
+    {
+        std::fprintf(stderr, "Could not cook the world assets (map names are limited to %d characters)\n", network::COOKED_MAP_NAME_CAPACITY - 1);
+        return 1;
+    }
+    
+    if (!VerifyCookedWorldAssets(cookedBlob, mapGlobalData, navmapSources))
+    {
+        std::fprintf(stderr, "Verification of the cooked world assets failed, %s was left untouched\n", options.mOutputPath.c_str());
+        return 1;
+    }
+    
+    if (!network::WriteCookedWorldAssets(options.mOutputPath, cookedBlob))
+    {
+        std::fprintf(stderr, "Could not write %s\n", options.mOutputPath.c_str());
+        return 1;
+    }
+    
+    std::printf("Cooked %zu maps into %s (%zu bytes, format version %u)\n", navmapSources.size(), options.mOutputPath.c_str(), cookedBlob.size(), network::COOKED_WORLD_FORMAT_VERSION);
+    return 0;
+}
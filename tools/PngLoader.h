@@ -0,0 +1,155 @@
+///------------------------------------------------------------------------------------------------
+///  PngLoader.h
+///  TinyMMOCommon
+///
+///  Created by agent on 17/10/2026
+///------------------------------------------------------------------------------------------------
+
+#ifndef PngLoader_h
+#define PngLoader_h
+
+///------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+///------------------------------------------------------------------------------------------------
+
+namespace tools
+{
+
+///------------------------------------------------------------------------------------------------
+/// Minimal PNG reader for the navmap assets: 8 bit RGB or RGBA, non interlaced. Always outputs
+/// RGBA, which is what Navmap expects.
+inline bool LoadPngRGBA(const std::string& filePath, std::vector<unsigned char>& outPixels, int& outWidth, int& outHeight)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    
+    const std::vector<unsigned char> fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    static const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (fileData.size() < 8 || !std::equal(PNG_SIGNATURE, PNG_SIGNATURE + 8, fileData.begin()))
+    {
+        return false;
+    }
+    
+    auto readBigEndian32 = [&](const size_t offset){ return (uint32_t(fileData[offset]) << 24) | (uint32_t(fileData[offset + 1]) << 16) | (uint32_t(fileData[offset + 2]) << 8) | uint32_t(fileData[offset + 3]); };
+    
+    int channelCount = 0;
+    std::vector<unsigned char> compressedData;
+    size_t offset = 8;
+    outWidth = outHeight = 0;
+    while (offset + 12 <= fileData.size())
+    {
+        const auto chunkLength = readBigEndian32(offset);
+        const std::string chunkType(fileData.begin() + offset + 4, fileData.begin() + offset + 8);
+        const auto chunkDataOffset = offset + 8;
+        if (chunkDataOffset + chunkLength + 4 > fileData.size())
+        {
+            return false;
+        }
+        
+        if (chunkType == "IHDR")
+        {
+            outWidth = static_cast<int>(readBigEndian32(chunkDataOffset));
+            outHeight = static_cast<int>(readBigEndian32(chunkDataOffset + 4));
+            const auto bitDepth = fileData[chunkDataOffset + 8];
+            const auto colorType = fileData[chunkDataOffset + 9];
+            const auto interlaceMethod = fileData[chunkDataOffset + 12];
+            if (bitDepth != 8 || (colorType != 2 && colorType != 6) || interlaceMethod != 0)
+            {
+                return false;
+            }
+            
+            channelCount = colorType == 6 ? 4 : 3;
+        }
+        else if (chunkType == "IDAT")
+        {
+            compressedData.insert(compressedData.end(), fileData.begin() + chunkDataOffset, fileData.begin() + chunkDataOffset + chunkLength);
+        }
+        else if (chunkType == "IEND")
+        {
+            break;
+        }
+        
+        offset = chunkDataOffset + chunkLength + 4;
+    }
+    
+    if (channelCount == 0 || outWidth <= 0 || outHeight <= 0)
+    {
+        return false;
+    }
+    
+    // Each row is prefixed by its filter type
+    const auto stride = static_cast<size_t>(outWidth) * channelCount;
+    std::vector<unsigned char> filteredData((stride + 1) * outHeight);
+    auto filteredDataSize = static_cast<uLongf>(filteredData.size());
+    if (uncompress(filteredData.data(), &filteredDataSize, compressedData.data(), static_cast<uLong>(compressedData.size())) != Z_OK || filteredDataSize != filteredData.size())
+    {
+        return false;
+    }
+    
+    std::vector<unsigned char> previousRow(stride, 0);
+    std::vector<unsigned char> row(stride);
+    outPixels.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+    for (int y = 0; y < outHeight; ++y)
+    {
+        const auto filterType = filteredData[y * (stride + 1)];
+        const auto* filteredRow = &filteredData[y * (stride + 1) + 1];
+        for (size_t x = 0; x < stride; ++x)
+        {
+            const int left = x >= static_cast<size_t>(channelCount) ? row[x - channelCount] : 0;
+            const int up = previousRow[x];
+            const int upLeft = x >= static_cast<size_t>(channelCount) ? previousRow[x - channelCount] : 0;
+            
+            int predictor = 0;
+            switch (filterType)
+            {
+                case 0: predictor = 0; break;
+                case 1: predictor = left; break;
+                case 2: predictor = up; break;
+                case 3: predictor = (left + up) / 2; break;
+                case 4:
+                {
+                    const auto estimate = left + up - upLeft;
+                    const auto leftDistance = std::abs(estimate - left);
+                    const auto upDistance = std::abs(estimate - up);
+                    const auto upLeftDistance = std::abs(estimate - upLeft);
+                    predictor = (leftDistance <= upDistance && leftDistance <= upLeftDistance) ? left : (upDistance <= upLeftDistance ? up : upLeft);
+                } break;
+                default: return false;
+            }
+            
+            row[x] = static_cast<unsigned char>(filteredRow[x] + predictor);
+        }
+        
+        for (int x = 0; x < outWidth; ++x)
+        {
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                outPixels[(static_cast<size_t>(y) * outWidth + x) * 4 + channel] = channel < channelCount ? row[x * channelCount + channel] : 255;
+            }
+        }
+        
+        std::swap(row, previousRow);
+    }
+    
+    return true;
+}
+
+///------------------------------------------------------------------------------------------------
+
+}
+
+///------------------------------------------------------------------------------------------------
+
+#endif /* PngLoader_h */